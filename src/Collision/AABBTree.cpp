@@ -0,0 +1,403 @@
+#include "AABBTree.h"
+
+#include <algorithm>
+#include <cmath>
+
+AABB AABB::Union(const AABB &a, const AABB &b) {
+  return {std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+          std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+}
+
+AABB AABBTree::fatten(const AABB &box) const {
+  return {box.minX - margin, box.minY - margin, box.maxX + margin, box.maxY + margin};
+}
+
+Entity *AABBTree::resolve(const Node &leaf) const {
+  // Without an owner there is no handle to check, and the raw pointer may
+  // be stale
+  return leaf.manager ? leaf.manager->Get(leaf.handle) : nullptr;
+}
+
+int AABBTree::allocate() {
+  int id;
+  if (freeList != kNull) {
+    id = freeList;
+    freeList = nodes[id].parent;
+    nodes[id] = Node{};
+  } else {
+    id = (int)nodes.size();
+    nodes.emplace_back();
+  }
+  nodes[id].height = 0;
+  return id;
+}
+
+void AABBTree::release(int id) {
+  nodes[id] = Node{};
+  nodes[id].parent = freeList;
+  freeList = id;
+}
+
+void AABBTree::Clear() {
+  nodes.clear();
+  root = kNull;
+  freeList = kNull;
+  leafOf.clear();
+}
+
+void AABBTree::insertLeaf(int leaf) {
+  if (root == kNull) {
+    root = leaf;
+    nodes[root].parent = kNull;
+    return;
+  }
+
+  // Descend towards the sibling that grows the tree's perimeter least
+  const AABB leafBox = nodes[leaf].box;
+  int index = root;
+  while (!nodes[index].IsLeaf()) {
+    const Node &node = nodes[index];
+    const float area = node.box.Perimeter();
+    const float combinedArea = AABB::Union(node.box, leafBox).Perimeter();
+
+    // Cost of making a new parent for this node and the leaf, and the
+    // minimum cost of pushing the leaf further down
+    const float cost = 2.0f * combinedArea;
+    const float inheritanceCost = 2.0f * (combinedArea - area);
+    auto descendCost = [&](int child) {
+      const Node &c = nodes[child];
+      float grown = AABB::Union(leafBox, c.box).Perimeter();
+      return (c.IsLeaf() ? grown : grown - c.box.Perimeter()) + inheritanceCost;
+    };
+    const float cost1 = descendCost(node.child1);
+    const float cost2 = descendCost(node.child2);
+
+    if (cost < cost1 && cost < cost2) break;
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+  const int sibling = index;
+
+  const int newParent = allocate();
+  const int oldParent = nodes[sibling].parent;
+  nodes[newParent].parent = oldParent;
+  nodes[newParent].box = AABB::Union(leafBox, nodes[sibling].box);
+  nodes[newParent].height = nodes[sibling].height + 1;
+  nodes[newParent].child1 = sibling;
+  nodes[newParent].child2 = leaf;
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+  if (oldParent == kNull) {
+    root = newParent;
+  } else if (nodes[oldParent].child1 == sibling) {
+    nodes[oldParent].child1 = newParent;
+  } else {
+    nodes[oldParent].child2 = newParent;
+  }
+
+  // Refit and rebalance the ancestors
+  for (index = nodes[leaf].parent; index != kNull; index = nodes[index].parent) {
+    index = balance(index);
+    Node &node = nodes[index];
+    node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+    node.box = AABB::Union(nodes[node.child1].box, nodes[node.child2].box);
+  }
+}
+
+void AABBTree::removeLeaf(int leaf) {
+  if (leaf == root) {
+    root = kNull;
+    return;
+  }
+
+  const int parent = nodes[leaf].parent;
+  const int grandParent = nodes[parent].parent;
+  const int sibling =
+      nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+  if (grandParent == kNull) {
+    root = sibling;
+    nodes[sibling].parent = kNull;
+    release(parent);
+    return;
+  }
+
+  if (nodes[grandParent].child1 == parent) {
+    nodes[grandParent].child1 = sibling;
+  } else {
+    nodes[grandParent].child2 = sibling;
+  }
+  nodes[sibling].parent = grandParent;
+  release(parent);
+
+  for (int index = grandParent; index != kNull; index = nodes[index].parent) {
+    index = balance(index);
+    Node &node = nodes[index];
+    node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+    node.box = AABB::Union(nodes[node.child1].box, nodes[node.child2].box);
+  }
+}
+
+int AABBTree::balance(int iA) {
+  Node &A = nodes[iA];
+  if (A.IsLeaf() || A.height < 2) {
+    return iA;
+  }
+
+  const int iB = A.child1;
+  const int iC = A.child2;
+  Node &B = nodes[iB];
+  Node &C = nodes[iC];
+  const int diff = C.height - B.height;
+
+  // Rotate C up
+  if (diff > 1) {
+    const int iF = C.child1;
+    const int iG = C.child2;
+    Node &F = nodes[iF];
+    Node &G = nodes[iG];
+
+    C.child1 = iA;
+    C.parent = A.parent;
+    A.parent = iC;
+    if (C.parent == kNull) {
+      root = iC;
+    } else if (nodes[C.parent].child1 == iA) {
+      nodes[C.parent].child1 = iC;
+    } else {
+      nodes[C.parent].child2 = iC;
+    }
+
+    if (F.height > G.height) {
+      C.child2 = iF;
+      A.child2 = iG;
+      G.parent = iA;
+      A.box = AABB::Union(B.box, G.box);
+      C.box = AABB::Union(A.box, F.box);
+      A.height = 1 + std::max(B.height, G.height);
+      C.height = 1 + std::max(A.height, F.height);
+    } else {
+      C.child2 = iG;
+      A.child2 = iF;
+      F.parent = iA;
+      A.box = AABB::Union(B.box, F.box);
+      C.box = AABB::Union(A.box, G.box);
+      A.height = 1 + std::max(B.height, F.height);
+      C.height = 1 + std::max(A.height, G.height);
+    }
+    return iC;
+  }
+
+  // Rotate B up
+  if (diff < -1) {
+    const int iD = B.child1;
+    const int iE = B.child2;
+    Node &D = nodes[iD];
+    Node &E = nodes[iE];
+
+    B.child1 = iA;
+    B.parent = A.parent;
+    A.parent = iB;
+    if (B.parent == kNull) {
+      root = iB;
+    } else if (nodes[B.parent].child1 == iA) {
+      nodes[B.parent].child1 = iB;
+    } else {
+      nodes[B.parent].child2 = iB;
+    }
+
+    if (D.height > E.height) {
+      B.child2 = iD;
+      A.child1 = iE;
+      E.parent = iA;
+      A.box = AABB::Union(C.box, E.box);
+      B.box = AABB::Union(A.box, D.box);
+      A.height = 1 + std::max(C.height, E.height);
+      B.height = 1 + std::max(A.height, D.height);
+    } else {
+      B.child2 = iE;
+      A.child1 = iD;
+      D.parent = iA;
+      A.box = AABB::Union(C.box, D.box);
+      B.box = AABB::Union(A.box, E.box);
+      A.height = 1 + std::max(C.height, D.height);
+      B.height = 1 + std::max(A.height, E.height);
+    }
+    return iB;
+  }
+
+  return iA;
+}
+
+void AABBTree::Update(const std::vector<Entity *> &entities) {
+  ++frame;
+  for (uint32_t i = 0; i < (uint32_t)entities.size(); ++i) {
+    Entity *entity = entities[i];
+    const AABB tight = AABB::FromRect(entity->GetBounds());
+
+    int leaf;
+    auto found = leafOf.find(entity);
+    if (found == leafOf.end()) {
+      leaf = allocate();
+      nodes[leaf].box = fatten(tight);
+      insertLeaf(leaf);
+      leafOf.emplace(entity, leaf);
+    } else {
+      leaf = found->second;
+      if (!nodes[leaf].box.Contains(tight)) {
+        // Left its fat box: re-insert around the new position
+        removeLeaf(leaf);
+        nodes[leaf].box = fatten(tight);
+        insertLeaf(leaf);
+      }
+    }
+
+    // Refreshed every time in case the address was reused by a new entity
+    Node &node = nodes[leaf];
+    node.tight = tight;
+    node.manager = entity->GetOwner();
+    node.handle = entity->GetHandle();
+    node.index = i;
+    node.seen = frame;
+  }
+
+  for (auto it = leafOf.begin(); it != leafOf.end();) {
+    if (nodes[it->second].seen != frame) {
+      removeLeaf(it->second);
+      release(it->second);
+      it = leafOf.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+template <typename Visit>
+void AABBTree::query(const AABB &box, Visit &&visit) const {
+  if (root == kNull) return;
+  std::vector<int> stack;
+  stack.push_back(root);
+  while (!stack.empty()) {
+    const int id = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[id];
+    if (!node.box.Overlaps(box)) continue;
+    if (node.IsLeaf()) {
+      if (!visit(id)) return;
+    } else {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+void AABBTree::QueryPairs(std::vector<CollisionPair> &pairs) const {
+  pairs.clear();
+  for (const auto &entry : leafOf) {
+    const int leaf = entry.second;
+    const Node &a = nodes[leaf];
+    query(a.tight, [this, leaf, &a, &pairs](int other) {
+      // Each pair is found from both leaves; keep the one from the lower id
+      if (other <= leaf) return true;
+      const Node &b = nodes[other];
+      if (a.tight.Overlaps(b.tight)) {
+        pairs.push_back(a.index < b.index ? CollisionPair{a.index, b.index}
+                                          : CollisionPair{b.index, a.index});
+      }
+      return true;
+    });
+  }
+  std::sort(pairs.begin(), pairs.end());
+}
+
+void AABBTree::QueryAABB(const SDL_FRect &region, std::vector<Entity *> &out,
+                         const EntityFilter &filter) const {
+  const AABB box = AABB::FromRect(region);
+  query(box, [this, &box, &out, &filter](int leaf) {
+    Entity *entity = resolve(nodes[leaf]);
+    if (entity && AABB::FromRect(entity->GetBounds()).Overlaps(box) &&
+        (!filter || filter(entity))) {
+      out.push_back(entity);
+    }
+    return true;
+  });
+}
+
+void AABBTree::QueryPoint(vec2 point, std::vector<Entity *> &out,
+                          const EntityFilter &filter) const {
+  QueryAABB(SDL_FRect{point.x, point.y, 0.0f, 0.0f}, out, filter);
+}
+
+// Slab test of the segment p + t * d, t in [0, maxT], against box. On a hit
+// returns the entry t (0 if p starts inside) and the face normal.
+static bool segmentHitsBox(vec2 p, vec2 d, float maxT, const AABB &box,
+                           float &t, vec2 &normal) {
+  float tMin = 0.0f, tMax = maxT;
+  normal = {0.0f, 0.0f};
+  const float origin[2] = {p.x, p.y};
+  const float dir[2] = {d.x, d.y};
+  const float lo[2] = {box.minX, box.minY};
+  const float hi[2] = {box.maxX, box.maxY};
+  for (int axis = 0; axis < 2; ++axis) {
+    if (std::fabs(dir[axis]) < 1e-12f) {
+      if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return false;
+      continue;
+    }
+    const float inv = 1.0f / dir[axis];
+    float t1 = (lo[axis] - origin[axis]) * inv;
+    float t2 = (hi[axis] - origin[axis]) * inv;
+    float sign = -1.0f;  // entering through the min face
+    if (t1 > t2) {
+      std::swap(t1, t2);
+      sign = 1.0f;
+    }
+    if (t1 > tMin) {
+      tMin = t1;
+      normal = axis == 0 ? vec2{sign, 0.0f} : vec2{0.0f, sign};
+    }
+    tMax = std::min(tMax, t2);
+    if (tMin > tMax) return false;
+  }
+  t = tMin;
+  return true;
+}
+
+bool AABBTree::Raycast(vec2 from, vec2 to, RaycastHit &hit,
+                       const EntityFilter &filter) const {
+  hit = RaycastHit{};
+  if (root == kNull) return false;
+
+  const vec2 d = sub(to, from);
+  float best = 1.0f;
+  bool found = false;
+  std::vector<int> stack;
+  stack.push_back(root);
+  while (!stack.empty()) {
+    const int id = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[id];
+    float t;
+    vec2 normal;
+    // Prune with the closest hit so far
+    if (!segmentHitsBox(from, d, best, node.box, t, normal)) continue;
+    if (!node.IsLeaf()) {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+      continue;
+    }
+
+    Entity *entity = resolve(node);
+    if (!entity || (filter && !filter(entity))) continue;
+    if (!segmentHitsBox(from, d, best, AABB::FromRect(entity->GetBounds()), t, normal)) {
+      continue;
+    }
+    if (!found || t < best) {
+      found = true;
+      best = t;
+      hit.entity = entity;
+      hit.fraction = t;
+      hit.point = add(from, mul(t, d));
+      hit.normal = normal;
+    }
+  }
+  return found;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Broadphase.h"
+#include "Entities/Entity.h"
+#include "Math/vec2.h"
+
+struct AABB {
+  float minX, minY, maxX, maxY;
+
+  static AABB FromRect(const SDL_FRect &r) { return {r.x, r.y, r.x + r.w, r.y + r.h}; }
+  static AABB Union(const AABB &a, const AABB &b);
+  // Edges touching counts as overlapping
+  bool Overlaps(const AABB &o) const {
+    return minX <= o.maxX && o.minX <= maxX && minY <= o.maxY && o.minY <= maxY;
+  }
+  bool Contains(const AABB &o) const {
+    return minX <= o.minX && minY <= o.minY && o.maxX <= maxX && o.maxY <= maxY;
+  }
+  float Perimeter() const { return 2.0f * ((maxX - minX) + (maxY - minY)); }
+};
+
+struct RaycastHit {
+  Entity *entity = nullptr;
+  float fraction = 1.0f;  // along from -> to
+  vec2 point = {0.0f, 0.0f};
+  vec2 normal = {0.0f, 0.0f};  // zero when the ray starts inside
+};
+
+// Return false to skip an entity in a query
+using EntityFilter = std::function<bool(Entity *)>;
+
+// Dynamic AABB tree over collidable entities (after Box2D's b2DynamicTree).
+// Leaves hold "fat" AABBs grown by a margin, so an entity only moves in the
+// tree once it leaves its fat box; inserts pick the cheapest sibling by
+// perimeter and rotations keep the tree height-balanced.
+//
+// Update() syncs the tree with a list of entities; those missing from the
+// list are removed. Queries prune on the fat boxes of the last Update() and
+// then test each candidate's current bounds, so they are exact only while
+// entities stay within the margin of where Update() last saw them: one that
+// has moved further may be missed, but nothing is reported that does not
+// currently overlap.
+//
+// Raycast, QueryAABB and QueryPoint resolve each leaf through its entity's
+// handle, so entities destroyed since the last Update() are skipped, and
+// entities not owned by an EntityManager (no handle) are never returned.
+// QueryPairs reports indices into the Update() list instead, so it covers
+// every entity of that list, owned or not.
+class AABBTree {
+ public:
+  explicit AABBTree(float margin = 8.0f) : margin(margin) {}
+
+  void SetMargin(float margin) { this->margin = margin; }
+  void Update(const std::vector<Entity *> &entities);
+
+  // Candidate pairs (AABBs overlap as of the last Update()) by index into
+  // that Update()'s list, sorted, no duplicates
+  void QueryPairs(std::vector<CollisionPair> &pairs) const;
+
+  // Closest entity hit by the segment from -> to
+  bool Raycast(vec2 from, vec2 to, RaycastHit &hit,
+               const EntityFilter &filter = nullptr) const;
+  // Entities whose bounds overlap region / contain point
+  void QueryAABB(const SDL_FRect &region, std::vector<Entity *> &out,
+                 const EntityFilter &filter = nullptr) const;
+  void QueryPoint(vec2 point, std::vector<Entity *> &out,
+                  const EntityFilter &filter = nullptr) const;
+
+  void Clear();
+  int GetHeight() const { return root == kNull ? 0 : nodes[root].height; }
+  size_t GetProxyCount() const { return leafOf.size(); }
+
+ private:
+  static constexpr int kNull = -1;
+
+  struct Node {
+    AABB box{};  // fat for leaves
+    int parent = kNull;  // next free node while on the free list
+    int child1 = kNull;
+    int child2 = kNull;
+    int height = -1;  // leaf = 0, free = -1
+
+    // Leaves only
+    AABB tight{};
+    EntityManager *manager = nullptr;
+    EntityHandle handle;
+    uint32_t index = 0;  // position in the last Update() list
+    uint64_t seen = 0;
+
+    bool IsLeaf() const { return child1 == kNull; }
+  };
+
+  std::vector<Node> nodes;
+  int root = kNull;
+  int freeList = kNull;
+  float margin;
+  uint64_t frame = 0;
+  std::unordered_map<const Entity *, int> leafOf;
+
+  int allocate();
+  void release(int id);
+  void insertLeaf(int leaf);
+  void removeLeaf(int leaf);
+  int balance(int a);
+  AABB fatten(const AABB &box) const;
+  // Live entity of a leaf, or nullptr if it was destroyed
+  Entity *resolve(const Node &leaf) const;
+
+  // Calls visit(leaf) for every leaf whose fat box overlaps box; stops when
+  // visit returns false
+  template <typename Visit>
+  void query(const AABB &box, Visit &&visit) const;
+};
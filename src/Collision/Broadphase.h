@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <tuple>
+
+// Candidate pair from a broadphase: indices into the entity list that was
+// passed to it, a < b. Broadphases return pairs sorted by (a, b), the order
+// the brute-force loop visits them, so callbacks fire in the same order
+// whichever broadphase is active.
+struct CollisionPair {
+  uint32_t a;
+  uint32_t b;
+
+  bool operator==(const CollisionPair &o) const { return a == o.a && b == o.b; }
+  bool operator<(const CollisionPair &o) const {
+    return std::tie(a, b) < std::tie(o.a, o.b);
+  }
+};
@@ -1,113 +1,222 @@
-#include "Collisions.h"
-
-#include <SDL3/SDL.h>
-#include "Math/vec2.h"
-// #include <algorithm>
-
-bool CollisionSystem::CheckCollision(const Entity *a, const Entity *b) const {
-  SDL_FRect A = a->GetBounds();
-  SDL_FRect B = b->GetBounds();
-  return CheckCollision(A, B);
-}
-
-bool CollisionSystem::CheckCollision(const SDL_FRect &a,
-                                     const SDL_FRect &b) const {
-  return SDL_HasRectIntersectionFloat(&a, &b);
-}
-
-void CollisionSystem::ProcessCollisions(std::vector<Entity *> &entities) {
-
-  const size_t n = entities.size();
-
-  if (n == 0)
-    return;
-    
-  for (size_t i = 0; i < n - 1; ++i) {
-    for (size_t j = i + 1; j < n; ++j) {
-      Entity *A = entities[i];
-      Entity *B = entities[j];
-
-      if (!A->collisionEnabled || !B->collisionEnabled)
-        continue;
-
-      SDL_FRect Ab = A->GetBounds();
-      SDL_FRect Bb = B->GetBounds();
-      if (!SDL_HasRectIntersectionFloat(&Ab, &Bb)) continue;
-
-      // Decide dynamic vs static priority
-      bool A_isKinematic = A->getComponent<CollisionComponent>("collision").isKinematic;
-      bool B_isKinematic = B->getComponent<CollisionComponent>("collision").isKinematic;
-      
-      Entity *dyn = (A_isKinematic && !B_isKinematic) ? B : A;
-      Entity *stat = (A_isKinematic && !B_isKinematic) ? A : B;
-
-      // If both are dynamic or both static, just treat A as dyn, B as stat
-      if (A_isKinematic == B_isKinematic) {
-        dyn = A;
-        stat = B;
-      }
-
-      SDL_FRect Db = dyn->GetBounds();
-      SDL_FRect Sb = stat->GetBounds();
-
-      SDL_FRect inter{};
-      SDL_GetRectIntersectionFloat(&Db, &Sb, &inter);
-
-      vec2 normals[4] = {
-          {1.0, 0.0},   // RIGHT
-          {-1.0, 0.0},  // LEFT
-          {0.0, 1.0},   // BOTTOM
-          {0.0, -1.0}   // TOP
-      };
-
-      vec2 db_collision_normal, sb_collision_normal;
-
-      float minimum_penetration = std::min(inter.w, inter.h);
-
-      if (inter.w < inter.h) /** side collision */ {
-        if (Db.x < Sb.x) {
-          db_collision_normal = normals[1];
-        } else {
-          db_collision_normal = normals[0];
-        }
-      } else /** top collision */ {
-        if (Db.y < Sb.y) {
-          db_collision_normal = normals[3];
-        } else {
-          db_collision_normal = normals[2];
-        }
-      }
-
-      sb_collision_normal = neg(db_collision_normal);
-
-      CollisionComponent& dynCollisionComponent = dyn->getComponent<CollisionComponent>("collision");
-      CollisionComponent& statCollisionComponent = stat->getComponent<CollisionComponent>("collision");
-
-      // If both entities are not ghost entities, resolve the collision
-      if(!dynCollisionComponent.ghostEntity && !statCollisionComponent.ghostEntity) {
-        if (!dynCollisionComponent.isKinematic && !statCollisionComponent.isKinematic) {
-          stat->position = add(stat->position, mul(minimum_penetration * 0.5f,
-                                                   sb_collision_normal));
-          dyn->position = add(dyn->position, mul(minimum_penetration * 0.5f,
-                                                 db_collision_normal));
-        } else {
-          dyn->position =
-              add(dyn->position, mul(minimum_penetration, db_collision_normal));
-        }
-      }
-      
-
-      vec2 collision_point = {.x = inter.x + 0.5f * inter.w,
-                              .y = inter.y + 0.5f * inter.h};
-
-      CollisionData cd_dyn = {.point = collision_point,
-                              .normal = db_collision_normal};
-
-      CollisionData cd_stat = {.point = collision_point,
-                               .normal = sb_collision_normal};
-
-      dyn->OnCollision(stat, &cd_dyn);
-      stat->OnCollision(dyn, &cd_stat);
-    }
-  }
+#include "Collisions.h"
+
+#include <SDL3/SDL.h>
+#include "Math/vec2.h"
+#include <algorithm>
+
+bool CollisionSystem::CheckCollision(const Entity *a, const Entity *b) const {
+  SDL_FRect A = a->GetBounds();
+  SDL_FRect B = b->GetBounds();
+  return CheckCollision(A, B);
+}
+
+bool CollisionSystem::CheckCollision(const SDL_FRect &a,
+                                     const SDL_FRect &b) const {
+  return SDL_HasRectIntersectionFloat(&a, &b);
+}
+
+void CollisionSystem::ProcessCollisions(const std::vector<Entity *> &entities) {
+
+  const size_t n = entities.size();
+
+  // The tree is only maintained while something reads it
+  if (broadphase == BroadphaseMode::AABBTree || spatialQueries) {
+    tree.Update(entities);
+  } else if (tree.GetProxyCount() > 0) {
+    tree.Clear();
+  }
+
+  if (n == 0)
+    return;
+
+  filters.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    const Entity *entity = entities[i];
+    filters[i] = entity->collisionEnabled
+                     ? entity->getComponent<CollisionComponent>(Components::Collision)
+                     : CollisionComponent{.ghostEntity = false, .category = 0, .mask = 0};
+  }
+
+  pairs.clear();
+  switch (broadphase) {
+    case BroadphaseMode::SpatialHash:
+      grid.Update(entities);
+      grid.QueryPairs(pairs);
+      break;
+    case BroadphaseMode::SweepAndPrune:
+      sweep.Update(entities);
+      sweep.QueryPairs(pairs);
+      break;
+    case BroadphaseMode::AABBTree:
+      tree.QueryPairs(pairs);
+      break;
+    case BroadphaseMode::BruteForce:
+      for (uint32_t i = 0; i < n - 1; ++i) {
+        for (uint32_t j = i + 1; j < n; ++j) {
+          if (ShouldCollide(filters[i], filters[j])) pairs.push_back({i, j});
+        }
+      }
+      break;
+  }
+  if (broadphase != BroadphaseMode::BruteForce) {
+    pairs.erase(std::remove_if(pairs.begin(), pairs.end(),
+                               [this](const CollisionPair &pair) {
+                                 return !ShouldCollide(filters[pair.a], filters[pair.b]);
+                               }),
+                pairs.end());
+  }
+
+  if (!parallelNarrowphase || !jobs || pairs.size() < kMinParallelPairs) {
+    for (const CollisionPair &pair : pairs) {
+      ResolvePair(entities[pair.a], entities[pair.b]);
+    }
+    return;
+  }
+
+  // Contacts for every pair from the positions at the start of the pass
+  contacts.resize(pairs.size());
+  hits.assign(pairs.size(), 0);
+  jobs->ParallelFor(0, pairs.size(), JobSystem::kAutoGrain,
+                    [this, &entities](size_t k) {
+                      const CollisionPair &pair = pairs[k];
+                      hits[k] = computeContact(entities[pair.a], entities[pair.b], contacts[k]);
+                    });
+
+  // Apply in pair order like the serial loop. A precomputed contact is only
+  // valid while neither entity has changed since the start of the pass;
+  // pairs touching a changed entity are recomputed against current state.
+  changed.assign(n, 0);
+  for (size_t k = 0; k < pairs.size(); ++k) {
+    const CollisionPair &pair = pairs[k];
+    Entity *A = entities[pair.a];
+    Entity *B = entities[pair.b];
+    if (changed[pair.a] || changed[pair.b]) {
+      const BodyState a = BodyState::Of(A), b = BodyState::Of(B);
+      ResolvePair(A, B);
+      changed[pair.a] |= !(a == BodyState::Of(A));
+      changed[pair.b] |= !(b == BodyState::Of(B));
+    } else if (hits[k]) {
+      const BodyState a = BodyState::Of(A), b = BodyState::Of(B);
+      applyContact(A, B, contacts[k]);
+      changed[pair.a] |= !(a == BodyState::Of(A));
+      changed[pair.b] |= !(b == BodyState::Of(B));
+    }
+  }
+}
+
+CollisionSystem::BodyState CollisionSystem::BodyState::Of(Entity *entity) {
+  BodyState state;
+  state.bounds = entity->GetBounds();
+  state.enabled = entity->collisionEnabled;
+  if (state.enabled) {
+    const CollisionComponent &collision =
+        entity->getComponent<CollisionComponent>(Components::Collision);
+    state.ghost = collision.ghostEntity;
+    state.kinematic = collision.isKinematic;
+  }
+  return state;
+}
+
+bool CollisionSystem::computeContact(Entity *A, Entity *B, Contact &contact) const {
+  if (!A->collisionEnabled || !B->collisionEnabled)
+    return false;
+
+  SDL_FRect Ab = A->GetBounds();
+  SDL_FRect Bb = B->GetBounds();
+  if (!SDL_HasRectIntersectionFloat(&Ab, &Bb)) return false;
+
+  // Decide dynamic vs static priority
+  bool A_isKinematic = A->getComponent<CollisionComponent>(Components::Collision).isKinematic;
+  bool B_isKinematic = B->getComponent<CollisionComponent>(Components::Collision).isKinematic;
+  
+  Entity *dyn = (A_isKinematic && !B_isKinematic) ? B : A;
+  Entity *stat = (A_isKinematic && !B_isKinematic) ? A : B;
+
+  // If both are dynamic or both static, just treat A as dyn, B as stat
+  if (A_isKinematic == B_isKinematic) {
+    dyn = A;
+    stat = B;
+  }
+
+  SDL_FRect Db = dyn->GetBounds();
+  SDL_FRect Sb = stat->GetBounds();
+
+  SDL_FRect inter{};
+  SDL_GetRectIntersectionFloat(&Db, &Sb, &inter);
+
+  vec2 normals[4] = {
+      {1.0, 0.0},   // RIGHT
+      {-1.0, 0.0},  // LEFT
+      {0.0, 1.0},   // BOTTOM
+      {0.0, -1.0}   // TOP
+  };
+
+  vec2 db_collision_normal;
+
+  float minimum_penetration = std::min(inter.w, inter.h);
+
+  if (inter.w < inter.h) /** side collision */ {
+    if (Db.x < Sb.x) {
+      db_collision_normal = normals[1];
+    } else {
+      db_collision_normal = normals[0];
+    }
+  } else /** top collision */ {
+    if (Db.y < Sb.y) {
+      db_collision_normal = normals[3];
+    } else {
+      db_collision_normal = normals[2];
+    }
+  }
+
+  contact.swapped = dyn != A;
+  contact.inter = inter;
+  contact.normal = db_collision_normal;
+  contact.penetration = minimum_penetration;
+  return true;
+}
+
+void CollisionSystem::applyContact(Entity *A, Entity *B, const Contact &contact) {
+  Entity *dyn = contact.swapped ? B : A;
+  Entity *stat = contact.swapped ? A : B;
+  const SDL_FRect &inter = contact.inter;
+  const float minimum_penetration = contact.penetration;
+  const vec2 db_collision_normal = contact.normal;
+  const vec2 sb_collision_normal = neg(db_collision_normal);
+
+  CollisionComponent& dynCollisionComponent = dyn->getComponent<CollisionComponent>(Components::Collision);
+  CollisionComponent& statCollisionComponent = stat->getComponent<CollisionComponent>(Components::Collision);
+
+  // If both entities are not ghost entities, resolve the collision
+  if(!dynCollisionComponent.ghostEntity && !statCollisionComponent.ghostEntity) {
+    if (!dynCollisionComponent.isKinematic && !statCollisionComponent.isKinematic) {
+      stat->position = add(stat->position, mul(minimum_penetration * 0.5f,
+                                               sb_collision_normal));
+      dyn->position = add(dyn->position, mul(minimum_penetration * 0.5f,
+                                             db_collision_normal));
+    } else {
+      dyn->position =
+          add(dyn->position, mul(minimum_penetration, db_collision_normal));
+    }
+  }
+  
+
+  vec2 collision_point = {.x = inter.x + 0.5f * inter.w,
+                          .y = inter.y + 0.5f * inter.h};
+
+  CollisionData cd_dyn = {.point = collision_point,
+                          .normal = db_collision_normal};
+
+  CollisionData cd_stat = {.point = collision_point,
+                           .normal = sb_collision_normal};
+
+  dyn->OnCollision(stat, &cd_dyn);
+  stat->OnCollision(dyn, &cd_stat);
+}
+
+void CollisionSystem::ResolvePair(Entity *A, Entity *B) {
+  Contact contact;
+  if (computeContact(A, B, contact)) {
+    applyContact(A, B, contact);
+  }
 }
\ No newline at end of file
@@ -1,13 +1,133 @@
-#pragma once
-#include "Entities/Entity.h"
-// #include <memory>
-#include <vector>
-
-class CollisionSystem {
- public:
-  bool CheckCollision(const Entity *a, const Entity *b) const;
-  bool CheckCollision(const SDL_FRect &a, const SDL_FRect &b) const;
-
-  // Resolves penetration and sets grounded when landing on static bodies.
-  void ProcessCollisions(std::vector<Entity *> &entities);
-};
+#pragma once
+#include "Entities/Entity.h"
+#include "Core/JobSystem.h"
+#include "AABBTree.h"
+#include "Broadphase.h"
+#include "SpatialHash.h"
+#include "SweepAndPrune.h"
+// #include <memory>
+#include <vector>
+
+// How ProcessCollisions finds candidate pairs before the AABB test
+enum class BroadphaseMode {
+  BruteForce,    // every pair, O(n^2); the default
+  SpatialHash,   // uniform grid, see SpatialHash
+  SweepAndPrune, // sorted along X, see SweepAndPrune
+  AABBTree       // the query tree below, see AABBTree
+};
+
+class CollisionSystem {
+ public:
+  bool CheckCollision(const Entity *a, const Entity *b) const;
+  bool CheckCollision(const SDL_FRect &a, const SDL_FRect &b) const;
+
+  // Resolves penetration and sets grounded when landing on static bodies.
+  // Expects collidable entities (EntityView::Collidable); others are skipped.
+  // Pairs are resolved in (i, j) order whichever broadphase is active.
+  // Candidate pairs rejected by ShouldCollide never reach the AABB test.
+  // With a broadphase other than BruteForce the candidates come from the
+  // positions at the start of the pass, so an overlap created by an earlier
+  // resolution in the same pass is only caught on the next call.
+  void ProcessCollisions(const std::vector<Entity *> &entities);
+
+  // Layer filter: each entity's category must be in the other's mask, and
+  // two kinematic bodies (e.g. static platforms) never collide unless
+  // SetCollideKinematicPairs(true) was called.
+  bool ShouldCollide(const CollisionComponent &a, const CollisionComponent &b) const {
+    return (a.category & b.mask) != 0 && (b.category & a.mask) != 0 &&
+           (collideKinematicPairs || !(a.isKinematic && b.isKinematic));
+  }
+  void SetCollideKinematicPairs(bool enabled) { collideKinematicPairs = enabled; }
+
+  // Parallel narrowphase: intersections, penetration and normals for all
+  // candidate pairs are computed on the JobSystem into a contact buffer,
+  // then position corrections and OnCollision callbacks are applied on the
+  // calling thread in (i, j) order. Pairs whose entities were moved earlier
+  // in the pass are recomputed, so results match the serial path exactly,
+  // provided OnCollision handlers only change the two entities involved.
+  // Passes with fewer than kMinParallelPairs pairs stay serial.
+  static constexpr size_t kMinParallelPairs = 256;
+  void SetJobSystem(JobSystem *jobs) { this->jobs = jobs; }
+  void SetParallelNarrowphase(bool enabled) { parallelNarrowphase = enabled; }
+  bool IsParallelNarrowphase() const { return parallelNarrowphase; }
+
+  // BruteForce unless changed, so existing games keep their behaviour;
+  // can be switched between frames, e.g. to compare modes on one scene
+  void SetBroadphase(BroadphaseMode mode) { broadphase = mode; }
+  BroadphaseMode GetBroadphase() const { return broadphase; }
+  // Grid cell size for BroadphaseMode::SpatialHash; roughly the size of a
+  // typical moving entity works best
+  void SetCellSize(float cellSize) { grid.SetCellSize(cellSize); }
+
+  // Candidate pairs of the last ProcessCollisions call
+  size_t GetLastPairCount() const { return pairs.size(); }
+
+  // Spatial queries over the collidable entities, answered by an AABB tree
+  // that ProcessCollisions brings up to date while queries are enabled or
+  // the AABBTree broadphase is active; otherwise they find nothing. Results
+  // are tested against current bounds but found through the tree of the
+  // last call, so an entity that moved more than the tree margin since may
+  // be missed; destroyed entities and ones not owned by an EntityManager
+  // are never returned.
+  void SetSpatialQueries(bool enabled) { spatialQueries = enabled; }
+  bool IsSpatialQueries() const { return spatialQueries; }
+  bool Raycast(vec2 from, vec2 to, RaycastHit &hit,
+               const EntityFilter &filter = nullptr) const {
+    return tree.Raycast(from, to, hit, filter);
+  }
+  void QueryAABB(const SDL_FRect &region, std::vector<Entity *> &out,
+                 const EntityFilter &filter = nullptr) const {
+    tree.QueryAABB(region, out, filter);
+  }
+  void QueryPoint(vec2 point, std::vector<Entity *> &out,
+                  const EntityFilter &filter = nullptr) const {
+    tree.QueryPoint(point, out, filter);
+  }
+  // How far an entity may move before it is re-inserted in the tree
+  void SetTreeMargin(float margin) { tree.SetMargin(margin); }
+
+ private:
+  // Result of the narrowphase test for one pair
+  struct Contact {
+    bool swapped;      // B is the dynamic body
+    SDL_FRect inter;   // overlap of the two bounds
+    vec2 normal;       // pushes the dynamic body out
+    float penetration;
+  };
+
+  // What a contact computed earlier in the pass depends on
+  struct BodyState {
+    SDL_FRect bounds;
+    bool enabled = false, ghost = false, kinematic = false;
+    static BodyState Of(Entity *entity);
+    bool operator==(const BodyState &o) const {
+      return bounds.x == o.bounds.x && bounds.y == o.bounds.y &&
+             bounds.w == o.bounds.w && bounds.h == o.bounds.h &&
+             enabled == o.enabled && ghost == o.ghost && kinematic == o.kinematic;
+    }
+  };
+
+  // Narrowphase for one candidate pair: AABB test, penetration resolution
+  // and OnCollision callbacks
+  void ResolvePair(Entity *A, Entity *B);
+  // Read-only part of ResolvePair; false if the pair does not collide
+  bool computeContact(Entity *A, Entity *B, Contact &contact) const;
+  void applyContact(Entity *A, Entity *B, const Contact &contact);
+
+  BroadphaseMode broadphase = BroadphaseMode::BruteForce;
+  bool spatialQueries = false;
+  bool collideKinematicPairs = false;
+  // Per-entity filter data for the current call, by entity index, so the
+  // pair filter does no component lookups
+  std::vector<CollisionComponent> filters;
+  ::SpatialHash grid;
+  ::SweepAndPrune sweep;
+  ::AABBTree tree;
+  std::vector<CollisionPair> pairs;  // reused across frames
+
+  JobSystem *jobs = nullptr;
+  bool parallelNarrowphase = false;
+  std::vector<Contact> contacts;  // by pair
+  std::vector<uint8_t> hits;      // by pair
+  std::vector<uint8_t> changed;   // by entity index
+};
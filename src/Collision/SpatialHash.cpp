@@ -0,0 +1,161 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cellSize) { SetCellSize(cellSize); }
+
+void SpatialHash::SetCellSize(float cellSize) {
+  this->cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+  invCellSize = 1.0f / this->cellSize;
+  Clear();
+}
+
+void SpatialHash::Clear() {
+  proxies.clear();
+  freeProxies.clear();
+  proxyOf.clear();
+  cells.clear();
+  oversized.clear();
+}
+
+SpatialHash::CellRange SpatialHash::rangeOf(const SDL_FRect &bounds) const {
+  CellRange range;
+  range.x0 = (int)std::floor(bounds.x * invCellSize);
+  range.y0 = (int)std::floor(bounds.y * invCellSize);
+  range.x1 = (int)std::floor((bounds.x + bounds.w) * invCellSize);
+  range.y1 = (int)std::floor((bounds.y + bounds.h) * invCellSize);
+  return range;
+}
+
+void SpatialHash::insert(uint32_t id) {
+  Proxy &proxy = proxies[id];
+  const CellRange &r = proxy.range;
+  const int64_t count = (int64_t)(r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1);
+  proxy.oversized = count > kMaxCellsPerEntity;
+  if (proxy.oversized) {
+    oversized.push_back(id);
+    return;
+  }
+  for (int y = r.y0; y <= r.y1; ++y) {
+    for (int x = r.x0; x <= r.x1; ++x) {
+      cells[cellKey(x, y)].push_back(id);
+    }
+  }
+}
+
+void SpatialHash::remove(uint32_t id) {
+  Proxy &proxy = proxies[id];
+  if (proxy.oversized) {
+    oversized.erase(std::find(oversized.begin(), oversized.end(), id));
+    return;
+  }
+  const CellRange &r = proxy.range;
+  for (int y = r.y0; y <= r.y1; ++y) {
+    for (int x = r.x0; x <= r.x1; ++x) {
+      auto it = cells.find(cellKey(x, y));
+      if (it == cells.end()) continue;
+      std::vector<uint32_t> &ids = it->second;
+      auto pos = std::find(ids.begin(), ids.end(), id);
+      if (pos != ids.end()) {
+        *pos = ids.back();
+        ids.pop_back();
+      }
+      if (ids.empty()) cells.erase(it);
+    }
+  }
+}
+
+void SpatialHash::Update(const std::vector<Entity *> &entities) {
+  ++frame;
+  for (uint32_t i = 0; i < (uint32_t)entities.size(); ++i) {
+    const Entity *entity = entities[i];
+    CellRange range = rangeOf(entity->GetBounds());
+
+    auto found = proxyOf.find(entity);
+    if (found == proxyOf.end()) {
+      uint32_t id;
+      if (!freeProxies.empty()) {
+        id = freeProxies.back();
+        freeProxies.pop_back();
+      } else {
+        id = (uint32_t)proxies.size();
+        proxies.emplace_back();
+      }
+      proxies[id] = Proxy{entity, range, false, i, frame};
+      proxyOf.emplace(entity, id);
+      insert(id);
+      continue;
+    }
+
+    uint32_t id = found->second;
+    Proxy &proxy = proxies[id];
+    proxy.index = i;
+    proxy.seen = frame;
+    if (!(proxy.range == range)) {
+      // Moved into different cells
+      remove(id);
+      proxies[id].range = range;
+      insert(id);
+    }
+  }
+
+  // Drop entities that were removed or stopped colliding
+  for (auto it = proxyOf.begin(); it != proxyOf.end();) {
+    uint32_t id = it->second;
+    if (proxies[id].seen != frame) {
+      remove(id);
+      proxies[id].entity = nullptr;
+      freeProxies.push_back(id);
+      it = proxyOf.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void SpatialHash::QueryPairs(std::vector<CollisionPair> &pairs) const {
+  pairs.clear();
+  auto emit = [this, &pairs](uint32_t p, uint32_t q) {
+    uint32_t a = proxies[p].index, b = proxies[q].index;
+    if (a == b) return;
+    pairs.push_back(a < b ? CollisionPair{a, b} : CollisionPair{b, a});
+  };
+
+  for (const auto &cell : cells) {
+    const std::vector<uint32_t> &ids = cell.second;
+    const int cx = (int)(uint32_t)(cell.first >> 32);
+    const int cy = (int)(uint32_t)cell.first;
+    for (size_t i = 0; i + 1 < ids.size(); ++i) {
+      const CellRange &ri = proxies[ids[i]].range;
+      for (size_t j = i + 1; j < ids.size(); ++j) {
+        const CellRange &rj = proxies[ids[j]].range;
+        // Pairs sharing several cells are emitted only from the first
+        // shared cell (top-left of the overlap of their ranges)
+        if (cx != std::max(ri.x0, rj.x0) || cy != std::max(ri.y0, rj.y0)) continue;
+        emit(ids[i], ids[j]);
+      }
+    }
+  }
+
+  if (!oversized.empty()) {
+    // One pass over the live normal proxies, each tested against the short
+    // oversized list by cell range, so only actual overlaps are emitted
+    for (uint32_t id = 0; id < (uint32_t)proxies.size(); ++id) {
+      const Proxy &proxy = proxies[id];
+      if (!proxy.entity || proxy.oversized) continue;
+      for (uint32_t big : oversized) {
+        if (rangesOverlap(proxy.range, proxies[big].range)) emit(big, id);
+      }
+    }
+    for (size_t i = 0; i + 1 < oversized.size(); ++i) {
+      for (size_t j = i + 1; j < oversized.size(); ++j) {
+        if (rangesOverlap(proxies[oversized[i]].range, proxies[oversized[j]].range)) {
+          emit(oversized[i], oversized[j]);
+        }
+      }
+    }
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+}
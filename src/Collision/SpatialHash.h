@@ -0,0 +1,75 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Broadphase.h"
+#include "Entities/Entity.h"
+
+// Uniform-grid broadphase. Each entity is bucketed into every cell its AABB
+// touches; entities sharing a cell become candidate pairs.
+//
+// The grid persists between frames. Update() only re-buckets entities whose
+// cell range changed, so static geometry and slow movers cost a range check.
+// Entities missing from the list passed to Update() are dropped.
+//
+// Entities spanning more than kMaxCellsPerEntity cells (level-sized ground)
+// are kept out of the grid in a separate list and paired with every entity
+// whose cell range overlaps theirs.
+class SpatialHash {
+ public:
+  static constexpr int kMaxCellsPerEntity = 256;
+
+  explicit SpatialHash(float cellSize = 128.0f);
+
+  // Changing the cell size rebuilds the grid on the next Update()
+  void SetCellSize(float cellSize);
+  float GetCellSize() const { return cellSize; }
+
+  // Syncs the grid with the current bounds of entities
+  void Update(const std::vector<Entity *> &entities);
+
+  // Candidate pairs for the entities of the last Update(), sorted, no
+  // duplicates. Pairs only share a cell; bounds may still miss.
+  void QueryPairs(std::vector<CollisionPair> &pairs) const;
+
+  void Clear();
+  size_t GetCellCount() const { return cells.size(); }
+
+ private:
+  struct CellRange {
+    int x0 = 0, y0 = 0, x1 = -1, y1 = -1;  // inclusive; empty by default
+    bool operator==(const CellRange &o) const {
+      return x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1;
+    }
+  };
+  struct Proxy {
+    const Entity *entity = nullptr;
+    CellRange range;
+    bool oversized = false;
+    uint32_t index = 0;  // position in the last Update() list
+    uint64_t seen = 0;   // frame of the last Update() that saw it
+  };
+
+  float cellSize;
+  float invCellSize;
+  uint64_t frame = 0;
+
+  std::vector<Proxy> proxies;
+  std::vector<uint32_t> freeProxies;
+  std::unordered_map<const Entity *, uint32_t> proxyOf;
+  std::unordered_map<uint64_t, std::vector<uint32_t>> cells;  // proxy ids
+  std::vector<uint32_t> oversized;                            // proxy ids
+
+  static uint64_t cellKey(int x, int y) {
+    return (uint64_t)(uint32_t)x << 32 | (uint32_t)y;
+  }
+  static bool rangesOverlap(const CellRange &a, const CellRange &b) {
+    return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+  }
+  CellRange rangeOf(const SDL_FRect &bounds) const;
+  void insert(uint32_t id);
+  void remove(uint32_t id);
+};
@@ -0,0 +1,70 @@
+#include "SweepAndPrune.h"
+
+#include <algorithm>
+
+void SweepAndPrune::Clear() {
+  endpoints.clear();
+  indexOf.clear();
+  lastSwaps = 0;
+}
+
+void SweepAndPrune::Update(const std::vector<Entity *> &entities) {
+  ++frame;
+  indexOf.clear();
+  for (uint32_t i = 0; i < (uint32_t)entities.size(); ++i) {
+    indexOf[entities[i]] = i;
+  }
+
+  // Refresh known entities in place, dropping the ones no longer listed
+  std::vector<bool> known(entities.size(), false);
+  for (Endpoint &e : endpoints) {
+    auto it = indexOf.find(e.entity);
+    if (it == indexOf.end()) continue;
+    const SDL_FRect b = entities[it->second]->GetBounds();
+    e.minX = b.x;
+    e.maxX = b.x + b.w;
+    e.minY = b.y;
+    e.maxY = b.y + b.h;
+    e.index = it->second;
+    e.seen = frame;
+    known[it->second] = true;
+  }
+  endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+                                 [this](const Endpoint &e) { return e.seen != frame; }),
+                  endpoints.end());
+
+  // New entities go on the end and are sorted in with everything else
+  for (uint32_t i = 0; i < (uint32_t)entities.size(); ++i) {
+    if (known[i]) continue;
+    const SDL_FRect b = entities[i]->GetBounds();
+    endpoints.push_back({b.x, b.x + b.w, b.y, b.y + b.h, entities[i], i, frame});
+  }
+
+  // Insertion sort: last frame's order is nearly sorted already
+  lastSwaps = 0;
+  for (size_t i = 1; i < endpoints.size(); ++i) {
+    Endpoint e = endpoints[i];
+    size_t j = i;
+    while (j > 0 && endpoints[j - 1].minX > e.minX) {
+      endpoints[j] = endpoints[j - 1];
+      --j;
+      ++lastSwaps;
+    }
+    endpoints[j] = e;
+  }
+}
+
+void SweepAndPrune::QueryPairs(std::vector<CollisionPair> &pairs) const {
+  pairs.clear();
+  const size_t n = endpoints.size();
+  for (size_t i = 0; i < n; ++i) {
+    const Endpoint &a = endpoints[i];
+    for (size_t j = i + 1; j < n && endpoints[j].minX <= a.maxX; ++j) {
+      const Endpoint &b = endpoints[j];
+      if (b.minY > a.maxY || a.minY > b.maxY) continue;
+      pairs.push_back(a.index < b.index ? CollisionPair{a.index, b.index}
+                                        : CollisionPair{b.index, a.index});
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Broadphase.h"
+#include "Entities/Entity.h"
+
+// Sort-and-sweep broadphase on the X axis. Entities are kept sorted by the
+// left edge of their AABB between frames and re-sorted with insertion sort,
+// which is close to O(n) when little moves relative to its neighbours. The
+// sweep then only compares each entity with those starting before its right
+// edge, so scenes spread out along X (side-scrolling levels) pay little for
+// entities far apart.
+//
+// Entities missing from the list passed to Update() are dropped.
+class SweepAndPrune {
+ public:
+  // Syncs the endpoint list with the current bounds of entities
+  void Update(const std::vector<Entity *> &entities);
+
+  // Candidate pairs (AABBs overlap on both axes, edges touching counts) for
+  // the entities of the last Update(), sorted, no duplicates
+  void QueryPairs(std::vector<CollisionPair> &pairs) const;
+
+  void Clear();
+  // Element moves made by the last Update()'s insertion sort
+  size_t GetLastSwapCount() const { return lastSwaps; }
+
+ private:
+  struct Endpoint {
+    float minX, maxX, minY, maxY;
+    const Entity *entity;
+    uint32_t index;  // position in the last Update() list
+    uint64_t seen;   // frame of the last Update() that saw it
+  };
+
+  std::vector<Endpoint> endpoints;  // sorted by minX
+  std::unordered_map<const Entity *, uint32_t> indexOf;  // this frame's list
+  uint64_t frame = 0;
+  size_t lastSwaps = 0;
+};
@@ -0,0 +1,430 @@
+#include "AssetManager.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+void TextureReleaseQueue::Push(SDL_Texture *texture) {
+  std::lock_guard<std::mutex> lock(mutex);
+  textures.push_back(texture);
+}
+
+TextureAsset::~TextureAsset() {
+  if (texture && releaseQueue) {
+    releaseQueue->Push(texture);
+  }
+}
+
+AtlasPage::~AtlasPage() {
+  if (texture && releaseQueue) {
+    releaseQueue->Push(texture);
+  }
+}
+
+bool TextureAsset::MapRect(const SDL_FRect *local, SDL_FRect &out) const {
+  if (!IsReady()) {
+    return false;  // placeholder is drawn whole
+  }
+  if (!page) {
+    if (!local) return false;
+    out = *local;
+    return true;
+  }
+  if (!local) {
+    out = region;
+    return true;
+  }
+  float x0 = std::clamp(local->x, 0.0f, region.w);
+  float y0 = std::clamp(local->y, 0.0f, region.h);
+  float x1 = std::clamp(local->x + local->w, 0.0f, region.w);
+  float y1 = std::clamp(local->y + local->h, 0.0f, region.h);
+  out = {region.x + x0, region.y + y0, x1 - x0, y1 - y0};
+  return true;
+}
+
+AssetManager::AssetManager(SDL_Renderer *renderer, JobSystem *jobs)
+    : renderer(renderer), jobs(jobs),
+      releaseQueue(std::make_shared<TextureReleaseQueue>()) {
+  // Magenta/black checker so missing art is obvious
+  if (renderer) {
+    SDL_Surface *surface = SDL_CreateSurface(2, 2, SDL_PIXELFORMAT_RGBA32);
+    if (surface) {
+      SDL_Rect a = {0, 0, 1, 1}, b = {1, 1, 1, 1};
+      SDL_FillSurfaceRect(surface, nullptr, SDL_MapSurfaceRGB(surface, 0, 0, 0));
+      SDL_FillSurfaceRect(surface, &a, SDL_MapSurfaceRGB(surface, 255, 0, 255));
+      SDL_FillSurfaceRect(surface, &b, SDL_MapSurfaceRGB(surface, 255, 0, 255));
+      placeholder = SDL_CreateTextureFromSurface(renderer, surface);
+      SDL_DestroySurface(surface);
+    }
+  }
+}
+
+AssetManager::~AssetManager() { ReleaseAll(); }
+
+TextureHandle AssetManager::LoadTexture(const std::string &path) {
+  TextureHandle asset = LoadTextureAsync(path);
+  if (asset && !asset->IsReady()) {
+    FinishLoading();
+  }
+  if (!asset || asset->state == AssetState::Failed) {
+    return nullptr;
+  }
+  return asset;
+}
+
+TextureHandle AssetManager::LoadTextureAsync(const std::string &path) {
+  TextureHandle asset;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = textures.find(path);
+    if (it != textures.end()) {
+      if (TextureHandle existing = it->second.lock()) {
+        return existing;
+      }
+    }
+    asset = std::make_shared<TextureAsset>();
+    asset->path = path;
+    asset->placeholder = placeholder;
+    asset->releaseQueue = releaseQueue;
+    asset->state = AssetState::Loading;
+    // Also drops the expired entry this replaces, if any
+    textures[path] = asset;
+  }
+
+  if (!renderer) {
+    readMetadata(*asset);
+    return asset;
+  }
+
+  inFlight++;
+  if (jobs) {
+    jobs->Submit([this, asset]() { decode(asset); }, &decodes);
+  } else {
+    decode(asset);
+  }
+  return asset;
+}
+
+void AssetManager::decode(TextureHandle asset) {
+  // File read and BMP decode only; SDL textures belong to the render thread
+  SDL_Surface *surface = SDL_LoadBMP(asset->path.c_str());
+  if (!surface) {
+    SDL_Log("Failed to load texture %s: %s", asset->path.c_str(), SDL_GetError());
+  }
+  std::lock_guard<std::mutex> lock(uploadMutex);
+  uploads.push_back({std::move(asset), surface});
+}
+
+void AssetManager::readMetadata(TextureAsset &asset) {
+  // BMP file header (14 bytes) followed by the DIB header; only the size is
+  // needed, so nothing past the first 26 bytes is read
+  unsigned char header[26] = {};
+  std::ifstream file(asset.path, std::ios::binary);
+  if (!file.read(reinterpret_cast<char *>(header), sizeof(header)) ||
+      header[0] != 'B' || header[1] != 'M') {
+    SDL_Log("Failed to read texture header %s", asset.path.c_str());
+    asset.state = AssetState::Failed;
+    return;
+  }
+  auto u16 = [&header](int at) { return (uint32_t)header[at] | (uint32_t)header[at + 1] << 8; };
+  auto u32 = [&u16](int at) { return u16(at) | u16(at + 2) << 16; };
+  if (u32(14) == 12) {
+    // OS/2 BITMAPCOREHEADER: 16-bit dimensions
+    asset.width = (int)u16(18);
+    asset.height = (int)u16(20);
+  } else {
+    asset.width = (int32_t)u32(18);
+    asset.height = std::abs((int32_t)u32(22));  // negative = top-down rows
+  }
+  asset.state = AssetState::Ready;
+}
+
+void AssetManager::upload(PendingUpload &pending) {
+  TextureAsset &asset = *pending.asset;
+  if (asset.page) {
+    // Packed into an atlas while this load was in flight
+    if (pending.surface) SDL_DestroySurface(pending.surface);
+    return;
+  }
+  if (!pending.surface) {
+    asset.state = AssetState::Failed;
+    return;
+  }
+  SDL_Surface *surface = pending.surface;
+  asset.texture = SDL_CreateTextureFromSurface(renderer, surface);
+  asset.width = surface->w;
+  asset.height = surface->h;
+  asset.bytes = (size_t)surface->w * surface->h * SDL_BYTESPERPIXEL(surface->format);
+  SDL_DestroySurface(surface);
+
+  if (!asset.texture) {
+    SDL_Log("Failed to create texture %s: %s", asset.path.c_str(), SDL_GetError());
+    asset.state = AssetState::Failed;
+    return;
+  }
+  asset.state = AssetState::Ready;
+}
+
+void AssetManager::destroyReleased() {
+  std::vector<SDL_Texture *> released;
+  {
+    std::lock_guard<std::mutex> lock(releaseQueue->mutex);
+    released.swap(releaseQueue->textures);
+  }
+  for (SDL_Texture *texture : released) {
+    SDL_DestroyTexture(texture);
+  }
+}
+
+size_t AssetManager::ProcessUploads(size_t maxUploads) {
+  // Anything released was last drawn by an earlier, already presented frame
+  destroyReleased();
+
+  size_t done = 0;
+  while (done < maxUploads) {
+    PendingUpload pending;
+    {
+      std::lock_guard<std::mutex> lock(uploadMutex);
+      if (uploads.empty()) {
+        break;
+      }
+      pending = std::move(uploads.front());
+      uploads.pop_front();
+    }
+    upload(pending);
+    inFlight--;
+    done++;
+  }
+  return done;
+}
+
+void AssetManager::Preload(const std::vector<std::string> &paths) {
+  for (const std::string &path : paths) {
+    TextureHandle asset = LoadTextureAsync(path);
+    std::lock_guard<std::mutex> lock(mutex);
+    preloaded.push_back(std::move(asset));
+  }
+}
+
+bool AssetManager::PreloadManifest(const std::string &manifestPath) {
+  std::ifstream manifest(manifestPath);
+  if (!manifest) {
+    SDL_Log("Failed to open asset manifest %s", manifestPath.c_str());
+    return false;
+  }
+  std::vector<std::string> paths;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    paths.push_back(line);
+  }
+  Preload(paths);
+  return true;
+}
+
+void AssetManager::BuildAtlases(const std::vector<std::string> &paths, int pageSize) {
+  if (!renderer) {
+    // Nothing to pack without textures; keep the metadata resident instead
+    Preload(paths);
+    return;
+  }
+
+  // Decode every sheet up front, in parallel when there is a pool
+  std::vector<SDL_Surface *> surfaces(paths.size(), nullptr);
+  auto decodeOne = [&paths, &surfaces](size_t i) {
+    SDL_Surface *loaded = SDL_LoadBMP(paths[i].c_str());
+    if (!loaded) {
+      SDL_Log("Failed to load texture %s: %s", paths[i].c_str(), SDL_GetError());
+      return;
+    }
+    // Uniform format so blits into the page are plain copies
+    surfaces[i] = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(loaded);
+  };
+  if (jobs) {
+    jobs->ParallelFor(0, paths.size(), 1, decodeOne);
+  } else {
+    for (size_t i = 0; i < paths.size(); ++i) decodeOne(i);
+  }
+
+  std::vector<std::pair<int, int>> sizes;
+  for (SDL_Surface *surface : surfaces) {
+    sizes.push_back(surface ? std::make_pair(surface->w, surface->h)
+                            : std::make_pair(pageSize + 1, 0));
+  }
+  AtlasPacker packer(pageSize);
+  std::vector<AtlasPacker::Placement> placements = packer.Pack(sizes);
+
+  // Compose each page on the CPU, then upload it once
+  std::vector<std::shared_ptr<AtlasPage>> pages;
+  for (int p = 0; p < packer.GetPageCount(); ++p) {
+    int height = packer.GetPageHeights()[p];
+    SDL_Surface *pageSurface = SDL_CreateSurface(pageSize, height, SDL_PIXELFORMAT_RGBA32);
+    if (!pageSurface) {
+      pages.push_back(nullptr);
+      continue;
+    }
+    SDL_FillSurfaceRect(pageSurface, nullptr, 0);
+    for (size_t i = 0; i < paths.size(); ++i) {
+      if (placements[i].page != p || !surfaces[i]) continue;
+      SDL_Rect dst = {placements[i].x, placements[i].y, surfaces[i]->w, surfaces[i]->h};
+      SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+      SDL_BlitSurface(surfaces[i], nullptr, pageSurface, &dst);
+    }
+    auto page = std::make_shared<AtlasPage>();
+    page->releaseQueue = releaseQueue;
+    page->texture = SDL_CreateTextureFromSurface(renderer, pageSurface);
+    page->width = pageSize;
+    page->height = height;
+    SDL_DestroySurface(pageSurface);
+    pages.push_back(page->texture ? page : nullptr);
+  }
+
+  for (size_t i = 0; i < paths.size(); ++i) {
+    SDL_Surface *surface = surfaces[i];
+    if (!surface) continue;
+    int p = placements[i].page;
+    std::shared_ptr<AtlasPage> page = p >= 0 ? pages[p] : nullptr;
+    if (!page) {
+      // Too big for a page (or the page failed): regular standalone asset
+      SDL_DestroySurface(surface);
+      TextureHandle standalone = LoadTexture(paths[i]);
+      if (standalone) {
+        std::lock_guard<std::mutex> lock(mutex);
+        preloaded.push_back(standalone);
+      }
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    TextureHandle asset;
+    auto it = textures.find(paths[i]);
+    if (it != textures.end()) asset = it->second.lock();
+    if (!asset) {
+      asset = std::make_shared<TextureAsset>();
+      asset->path = paths[i];
+      asset->placeholder = placeholder;
+      asset->releaseQueue = releaseQueue;
+      textures[paths[i]] = asset;
+    }
+    if (asset->texture) {
+      SDL_DestroyTexture(asset->texture);
+      asset->texture = nullptr;
+    }
+    asset->page = page;
+    asset->region = {(float)placements[i].x, (float)placements[i].y,
+                     (float)surface->w, (float)surface->h};
+    asset->width = surface->w;
+    asset->height = surface->h;
+    asset->bytes = (size_t)surface->w * surface->h * SDL_BYTESPERPIXEL(surface->format);
+    asset->state = AssetState::Ready;
+    preloaded.push_back(asset);
+    SDL_DestroySurface(surface);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto &page : pages) {
+    if (page) atlasPages.push_back(page);
+  }
+}
+
+size_t AssetManager::GetAtlasPageCount() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return atlasPages.size();
+}
+
+void AssetManager::FinishLoading() {
+  if (jobs) {
+    jobs->WaitForCounter(decodes);
+  }
+  ProcessUploads(SIZE_MAX);
+}
+
+size_t AssetManager::PendingCount() { return inFlight.load(); }
+
+std::vector<AssetMemoryInfo> AssetManager::GetMemoryReport() {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<AssetMemoryInfo> report;
+  for (auto it = textures.begin(); it != textures.end();) {
+    TextureHandle asset = it->second.lock();
+    if (!asset) {
+      it = textures.erase(it);
+      continue;
+    }
+    // use_count includes the local copy
+    report.push_back({asset->path, asset->bytes, asset.use_count() - 1});
+    ++it;
+  }
+  return report;
+}
+
+size_t AssetManager::GetTotalBytes() {
+  size_t total = 0;
+  for (const AssetMemoryInfo &info : GetMemoryReport()) {
+    total += info.bytes;
+  }
+  return total;
+}
+
+void AssetManager::PrintMemoryReport() {
+  size_t total = 0;
+  std::cout << "Loaded textures:" << std::endl;
+  for (const AssetMemoryInfo &info : GetMemoryReport()) {
+    std::cout << "  " << info.path << ": " << info.bytes / 1024 << " KB, "
+              << info.users << " users" << std::endl;
+    total += info.bytes;
+  }
+  std::cout << "  total: " << total / 1024 << " KB" << std::endl;
+  std::cout << "  atlas pages: " << GetAtlasPageCount() << std::endl;
+}
+
+void AssetManager::ReleaseAll() {
+  // Let in-flight decodes finish, then throw their surfaces away
+  if (jobs && !decodes.IsDone()) {
+    jobs->WaitForCounter(decodes);
+  }
+  {
+    std::lock_guard<std::mutex> lock(uploadMutex);
+    for (PendingUpload &pending : uploads) {
+      if (pending.surface) {
+        SDL_DestroySurface(pending.surface);
+      }
+      pending.asset->state = AssetState::Failed;
+    }
+    uploads.clear();
+    inFlight = 0;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto &entry : textures) {
+    if (TextureHandle asset = entry.second.lock()) {
+      if (asset->texture) {
+        SDL_DestroyTexture(asset->texture);
+        asset->texture = nullptr;
+      }
+      asset->placeholder = nullptr;
+    }
+  }
+  textures.clear();
+  preloaded.clear();
+  for (auto &page : atlasPages) {
+    if (page->texture) {
+      SDL_DestroyTexture(page->texture);
+      page->texture = nullptr;
+    }
+  }
+  atlasPages.clear();
+  destroyReleased();
+
+  if (placeholder) {
+    SDL_DestroyTexture(placeholder);
+    placeholder = nullptr;
+  }
+}
@@ -0,0 +1,172 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AtlasPacker.h"
+#include "JobSystem.h"
+
+enum class AssetState { Loading, Ready, Failed };
+
+// SDL textures whose last handle was dropped, waiting to be destroyed on
+// the render thread. Handles die wherever their last owner does (render
+// snapshots, entities on the simulation thread), so destructors only queue
+// the texture here; AssetManager::ProcessUploads() destroys it. Shared with
+// the assets, so it outlives the manager if they do.
+struct TextureReleaseQueue {
+  std::mutex mutex;
+  std::vector<SDL_Texture *> textures;
+
+  void Push(SDL_Texture *texture);
+};
+
+// One packed texture holding several sprite sheets (see BuildAtlases).
+struct AtlasPage {
+  SDL_Texture *texture = nullptr;
+  int width = 0;
+  int height = 0;
+  std::shared_ptr<TextureReleaseQueue> releaseQueue;
+
+  AtlasPage() = default;
+  AtlasPage(const AtlasPage &) = delete;
+  AtlasPage &operator=(const AtlasPage &) = delete;
+  ~AtlasPage();
+};
+
+// One loaded texture, shared by every entity that uses the same file. The
+// SDL texture is released when the last handle goes away and destroyed by
+// the render thread on its next ProcessUploads().
+//
+// Assets requested with LoadTextureAsync start out Loading and draw as the
+// manager's placeholder until the render thread uploads them.
+//
+// A sheet packed into an atlas lives in a region of a shared page instead
+// of its own texture; source rects are relative to the sheet either way and
+// go through MapRect() before drawing.
+struct TextureAsset {
+  std::string path;
+  SDL_Texture *texture = nullptr;      // own texture; null until uploaded
+  SDL_Texture *placeholder = nullptr;  // not owned
+  std::shared_ptr<AtlasPage> page;     // set once packed into an atlas
+  SDL_FRect region = {0, 0, 0, 0};     // sheet bounds within page
+  int width = 0;
+  int height = 0;
+  size_t bytes = 0;  // decoded size: width * height * bytes per pixel
+  std::atomic<AssetState> state{AssetState::Ready};
+  std::shared_ptr<TextureReleaseQueue> releaseQueue;
+
+  bool IsReady() const { return state.load(std::memory_order_acquire) == AssetState::Ready; }
+  SDL_Texture *Current() const {
+    if (page) return page->texture;
+    return texture ? texture : placeholder;
+  }
+
+  // Converts a sheet-local source rect (nullptr = whole sheet) to the rect
+  // to pass to SDL for Current(). Returns false if the whole texture should
+  // be drawn, i.e. no source rect. Local rects are clipped to the sheet so
+  // they cannot sample a neighbour in the atlas.
+  bool MapRect(const SDL_FRect *local, SDL_FRect &out) const;
+
+  TextureAsset() = default;
+  TextureAsset(const TextureAsset &) = delete;
+  TextureAsset &operator=(const TextureAsset &) = delete;
+  ~TextureAsset();
+};
+
+using TextureHandle = std::shared_ptr<TextureAsset>;
+
+struct AssetMemoryInfo {
+  std::string path;
+  size_t bytes;
+  long users;  // live handles, including any held by the caller
+};
+
+// Path-keyed texture cache. Loads return the existing asset while anyone
+// still holds a handle to it and only go to disk otherwise, so N entities
+// sharing a sprite sheet cost one file read and one texture.
+//
+// Async loads read and decode the file on the JobSystem; the SDL texture is
+// created later by ProcessUploads(), which must run on the render thread.
+//
+// Without a renderer (headless engines) loads are metadata-only: the file's
+// header is read for width/height and the asset is Ready at once with no
+// texture and no pixel memory.
+class AssetManager {
+ public:
+  // Without a JobSystem, async loads fall back to loading synchronously.
+  explicit AssetManager(SDL_Renderer *renderer, JobSystem *jobs = nullptr);
+  ~AssetManager();
+
+  // Blocking load; nullptr if the file cannot be loaded (not cached).
+  // Render thread only.
+  TextureHandle LoadTexture(const std::string &path);
+
+  // Returns immediately with a Loading asset (or the cached one). Safe from
+  // any thread. Failed loads keep drawing the placeholder.
+  TextureHandle LoadTextureAsync(const std::string &path);
+
+  // Destroys textures released since the last call, then creates textures
+  // for up to maxUploads decoded images. Render thread only; call once per
+  // frame, before drawing.
+  size_t ProcessUploads(size_t maxUploads = 8);
+
+  // Starts async loads for every path and keeps them resident until
+  // ReleaseAll(), so startup assets survive with no entities using them yet.
+  void Preload(const std::vector<std::string> &paths);
+  // Same, reading one path per line; blank lines and '#' comments skipped.
+  bool PreloadManifest(const std::string &manifestPath);
+
+  // Packs the given sheets into as few pageSize x pageSize atlases as
+  // possible and points their assets (existing or new) at the pages. Sheets
+  // that do not fit a page are loaded as standalone textures. Packed assets
+  // stay resident like preloaded ones. Render thread only.
+  void BuildAtlases(const std::vector<std::string> &paths, int pageSize = 4096);
+  size_t GetAtlasPageCount();
+  // Blocks until every pending async load is decoded and uploaded. Render
+  // thread only.
+  void FinishLoading();
+  size_t PendingCount();
+
+  std::vector<AssetMemoryInfo> GetMemoryReport();
+  size_t GetTotalBytes();
+  void PrintMemoryReport();
+
+  // Destroys every SDL texture while the renderer is still alive; handles
+  // that outlive this keep a null texture.
+  void ReleaseAll();
+
+  SDL_Renderer *GetRenderer() const { return renderer; }
+  bool IsMetadataOnly() const { return renderer == nullptr; }
+
+ private:
+  struct PendingUpload {
+    TextureHandle asset;
+    SDL_Surface *surface;  // null if decoding failed
+  };
+
+  SDL_Renderer *renderer;
+  JobSystem *jobs;
+  SDL_Texture *placeholder = nullptr;
+  std::shared_ptr<TextureReleaseQueue> releaseQueue;
+
+  std::mutex mutex;
+  std::unordered_map<std::string, std::weak_ptr<TextureAsset>> textures;
+  std::vector<TextureHandle> preloaded;
+  std::vector<std::shared_ptr<AtlasPage>> atlasPages;
+
+  JobCounter decodes;
+  std::mutex uploadMutex;
+  std::deque<PendingUpload> uploads;
+  std::atomic<size_t> inFlight{0};  // requested but not yet uploaded
+
+  void decode(TextureHandle asset);
+  void readMetadata(TextureAsset &asset);
+  void upload(PendingUpload &pending);
+  void destroyReleased();
+};
@@ -0,0 +1,47 @@
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <numeric>
+
+AtlasPacker::AtlasPacker(int pageSize, int padding)
+    : pageSize(pageSize), padding(padding) {}
+
+std::vector<AtlasPacker::Placement> AtlasPacker::Pack(
+    const std::vector<std::pair<int, int>> &sizes) {
+  std::vector<Placement> placements(sizes.size());
+  pageHeights.clear();
+
+  std::vector<size_t> order(sizes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+    return sizes[a].second > sizes[b].second;
+  });
+
+  int page = -1;
+  int shelfX = 0, shelfY = 0, shelfHeight = 0;
+  for (size_t index : order) {
+    int w = sizes[index].first;
+    int h = sizes[index].second;
+    if (w > pageSize || h > pageSize) {
+      continue;  // stays a standalone texture
+    }
+
+    if (page < 0 || shelfX + w > pageSize) {
+      // Next shelf, or next page if the shelf would not fit
+      shelfY += shelfHeight;
+      shelfX = 0;
+      shelfHeight = 0;
+      if (page < 0 || shelfY + h > pageSize) {
+        page++;
+        pageHeights.push_back(0);
+        shelfY = 0;
+      }
+    }
+
+    placements[index] = {page, shelfX, shelfY};
+    shelfX += w + padding;
+    shelfHeight = std::max(shelfHeight, h + padding);
+    pageHeights[page] = std::max(pageHeights[page], shelfY + h);
+  }
+  return placements;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+
+// Shelf packer for sprite sheets. Rects are placed tallest first, left to
+// right along horizontal shelves, opening a new page when a rect no longer
+// fits. Sheets are few and large, so this stays within a few percent of
+// optimal without the bookkeeping of a skyline or maxrects packer.
+class AtlasPacker {
+ public:
+  struct Placement {
+    int page = -1;  // -1 if the rect is larger than a page
+    int x = 0;
+    int y = 0;
+  };
+
+  // padding is left between rects so linear filtering does not bleed
+  explicit AtlasPacker(int pageSize, int padding = 2);
+
+  // One placement per input size, in input order.
+  std::vector<Placement> Pack(const std::vector<std::pair<int, int>> &sizes);
+
+  int GetPageCount() const { return (int)pageHeights.size(); }
+  // Used height of each page, so pages can be allocated no taller than needed
+  const std::vector<int> &GetPageHeights() const { return pageHeights; }
+  int GetPageSize() const { return pageSize; }
+
+ private:
+  int pageSize;
+  int padding;
+  std::vector<int> pageHeights;
+};
@@ -0,0 +1,115 @@
+#include "FrameGraph.h"
+
+#include <thread>
+
+int FrameGraph::AddStage(const std::string &name, FrameResourceMask reads,
+                         FrameResourceMask writes, StageFn fn, bool mainThread) {
+  auto stage = std::make_unique<Stage>();
+  stage->name = name;
+  stage->reads = reads;
+  stage->writes = writes;
+  stage->fn = std::move(fn);
+  stage->mainThread = mainThread;
+  stages.push_back(std::move(stage));
+  return (int)stages.size() - 1;
+}
+
+void FrameGraph::Clear() {
+  stages.clear();
+  mainThreadReady.clear();
+}
+
+void FrameGraph::buildEdges() {
+  for (auto &stage : stages) {
+    stage->successors.clear();
+    stage->dependencyCount = 0;
+  }
+
+  // A later stage depends on an earlier one whenever they touch a common
+  // resource and at least one of them writes it
+  for (size_t i = 0; i < stages.size(); ++i) {
+    Stage &a = *stages[i];
+    for (size_t j = i + 1; j < stages.size(); ++j) {
+      Stage &b = *stages[j];
+      bool conflict = (a.writes & (b.reads | b.writes)) || (a.reads & b.writes);
+      if (conflict) {
+        a.successors.push_back((int)j);
+        b.dependencyCount++;
+      }
+    }
+  }
+}
+
+void FrameGraph::schedule(int index) {
+  counter.pending.fetch_add(1, std::memory_order_relaxed);
+  if (stages[index]->mainThread) {
+    {
+      std::lock_guard<std::mutex> lock(mainThreadMutex);
+      mainThreadReady.push_back(index);
+    }
+    mainThreadReadyCount.fetch_add(1);
+    // Execute may be parked in the pool waiting for exactly this
+    jobSystem.WakeWaiters();
+    return;
+  }
+  jobSystem.Submit([this, index]() { runStage(index); });
+}
+
+void FrameGraph::runStage(int index) {
+  Stage &stage = *stages[index];
+  if (stage.fn) {
+    stage.fn();
+  }
+  for (int successor : stage.successors) {
+    if (stages[successor]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      schedule(successor);
+    }
+  }
+  if (counter.pending.fetch_sub(1) == 1) {
+    jobSystem.WakeWaiters();
+  }
+}
+
+void FrameGraph::Execute() {
+  if (stages.empty()) {
+    return;
+  }
+
+  buildEdges();
+  for (auto &stage : stages) {
+    stage->remaining.store(stage->dependencyCount, std::memory_order_relaxed);
+  }
+  for (size_t i = 0; i < stages.size(); ++i) {
+    if (stages[i]->dependencyCount == 0) {
+      schedule((int)i);
+    }
+  }
+
+  // Run main-thread stages as they become ready and help the pool otherwise;
+  // sleep once there is neither
+  int idleSpins = 0;
+  while (!counter.IsDone()) {
+    int ready = -1;
+    {
+      std::lock_guard<std::mutex> lock(mainThreadMutex);
+      if (!mainThreadReady.empty()) {
+        ready = mainThreadReady.back();
+        mainThreadReady.pop_back();
+        mainThreadReadyCount.fetch_sub(1);
+      }
+    }
+    if (ready >= 0) {
+      idleSpins = 0;
+      runStage(ready);
+    } else if (jobSystem.RunOneJob()) {
+      idleSpins = 0;
+    } else if (++idleSpins < JobSystem::kSpinsBeforePark) {
+      std::this_thread::yield();
+    } else {
+      idleSpins = 0;
+      jobSystem.ParkUntil([this] {
+        return counter.pending.load() == 0 || mainThreadReadyCount.load() > 0;
+      });
+    }
+  }
+}
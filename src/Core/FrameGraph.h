@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "JobSystem.h"
+
+// Resources a frame stage can declare as read or written. Games can add their
+// own bits starting at User.
+//
+// Entity state is split so stages can declare only what they touch:
+// Entities is the entity list and gameplay state (components, timelines,
+// animation), Transforms is position, velocity and size, and Contacts is
+// the collision pass's pairs and callbacks. The bits are independent, so a
+// stage that moves entities must declare Transforms even if it also
+// declares Entities.
+namespace FrameResource {
+enum : uint32_t {
+  None = 0,
+  Input = 1u << 0,
+  Time = 1u << 1,
+  Entities = 1u << 2,
+  Screen = 1u << 3,
+  NetworkIn = 1u << 4,
+  NetworkOut = 1u << 5,
+  Snapshot = 1u << 6,
+  Transforms = 1u << 7,
+  Contacts = 1u << 8,
+  RenderCapture = 1u << 9,  // sprites captured for drawing
+  User = 1u << 16
+};
+}
+using FrameResourceMask = uint32_t;
+
+// Per-frame task graph.
+//
+// Stages are added in program order together with the resources they read
+// and write. Execute() derives the dependency DAG from those declarations
+// (read-after-write, write-after-read and write-after-write on any shared
+// bit) and runs every stage whose dependencies are done on the JobSystem, so
+// independent stages overlap. Stages flagged mainThread (SDL rendering,
+// texture creation) run on the thread that calls Execute().
+class FrameGraph {
+ public:
+  using StageFn = std::function<void()>;
+
+  explicit FrameGraph(JobSystem &jobSystem) : jobSystem(jobSystem) {}
+
+  int AddStage(const std::string &name, FrameResourceMask reads,
+               FrameResourceMask writes, StageFn fn, bool mainThread = false);
+  void Clear();
+
+  // Blocks until every stage has run.
+  void Execute();
+
+  size_t GetStageCount() const { return stages.size(); }
+  const std::string &GetStageName(int stage) const { return stages[stage]->name; }
+  const std::vector<int> &GetSuccessors(int stage) const { return stages[stage]->successors; }
+
+ private:
+  struct Stage {
+    std::string name;
+    FrameResourceMask reads;
+    FrameResourceMask writes;
+    StageFn fn;
+    bool mainThread;
+    std::vector<int> successors;
+    int dependencyCount = 0;
+    std::atomic<int> remaining{0};
+  };
+
+  void buildEdges();
+  void schedule(int stage);
+  void runStage(int stage);
+
+  JobSystem &jobSystem;
+  std::vector<std::unique_ptr<Stage>> stages;
+  JobCounter counter;
+
+  std::mutex mainThreadMutex;
+  std::vector<int> mainThreadReady;
+  std::atomic<int> mainThreadReadyCount{0};  // lets Execute park without the lock
+};
@@ -1,176 +1,286 @@
-// GameEngine.cpp
-// #include <memory>
-#include "GameEngine.h"
-
-#include <algorithm>
-#include <iostream>
-using namespace std;
-
-// GameEngine Implementation
-GameEngine::GameEngine() : window(nullptr), renderer(nullptr), running(false), headlessMode(false), jobSystem(2) {}
-GameEngine::GameEngine(bool headless) : window(nullptr), renderer(nullptr), running(false), headlessMode(headless), jobSystem(2) {}
-
-
-GameEngine::~GameEngine() { Shutdown(); }
-
-bool GameEngine::Initialize(const char *title, int resx, int resy, float timeScale = 1.0f) {
-  // Initialize SDL
-  if (!SDL_Init(SDL_INIT_VIDEO)) {
-    SDL_Log("Failed to initialize SDL: %s", SDL_GetError());
-    return false;
-  }
-
-  if(timeScale < 0.5 || timeScale > 2.0) {
-    SDL_Log("Time scale must be between 0.5 and 2.0");
-    return false;
-  }
-
-  tickRate = 60.0f * timeScale;
-  winsizeX = resx;
-  winsizeY = resy;
-  if (!headlessMode) {
-    // Create window normally
-    window = SDL_CreateWindow(title, resx, resy, SDL_WINDOW_RESIZABLE);
-    if (!window) {
-      SDL_Log("Failed to create window: %s", SDL_GetError());
-      return false;
-    }
-
-    // Create renderer
-    renderer = SDL_CreateRenderer(window, nullptr);
-    if (!renderer) {
-      SDL_Log("Failed to create renderer: %s", SDL_GetError());
-      return false;
-    }
-  } else {
-    // Create hidden window for headless mode
-    window = SDL_CreateWindow(title, resx, resy, SDL_WINDOW_HIDDEN);
-    if (!window) {
-      SDL_Log("Failed to create hidden window: %s", SDL_GetError());
-      return false;
-    }
-
-    // Create renderer
-    renderer = SDL_CreateRenderer(window, nullptr);
-    if (!renderer) {
-      SDL_Log("Failed to create renderer: %s", SDL_GetError());
-      return false;
-    }
-  }
-
-  // Initialize systems
-  physics = std::make_unique<PhysicsSystem>(3);
-  input = std::make_unique<InputManager>();
-  collision = std::make_unique<CollisionSystem>();
-  renderSystem = std::make_unique<RenderSystem>(renderer, resx, resy);
-  rootTimeline = std::make_unique<Timeline>(timeScale, nullptr);
-  entityManager = std::make_unique<EntityManager>();
-
-  running = true;
-  return true;
-}
-
-void GameEngine::Run() {
-  SDL_Event event;
-  Uint32 lastTime = SDL_GetTicks();
-
-  while (running) {
-    // Calculate delta time
-    Uint32 currentTime = SDL_GetTicks();
-    float deltaTime = (float)(currentTime - lastTime);
-    lastTime = currentTime;
-
-    // Handle events
-    while (SDL_PollEvent(&event)) {
-      if (event.type == SDL_EVENT_QUIT ||
-          input->IsKeyPressed(SDL_SCANCODE_ESCAPE)) {
-        running = false;
-      }
-    }
-    std::vector<Entity *> &entities = entityManager->getEntityVectorRef();
-
-    // Update engine systems in parallel
-    UpdateSystemsParallel(deltaTime / 1000.0);
-    // update game
-    Update(deltaTime / 1000.0, entities);
-
-    // Render
-    Render(entities);
-
-    float delay = std::max(0.0, 1000.0 / tickRate - deltaTime);
-    SDL_Delay(delay);
-  }
-}
-
-void GameEngine::Update(float deltaTime, std::vector<Entity *> &entities) {
-  // Update all entities
-  for (auto &entity : entities) {
-    float entityDeltaTime = entity->timeline->getDeltaTime();
-    entity->Update(entityDeltaTime, input.get(), entityManager.get());
-
-  }
-  physics->ApplyPhysicsMultithreaded(entities);
-  // Process collisions
-  collision->ProcessCollisions(entities);
-}
-
-void GameEngine::Render(std::vector<Entity *> &entities) {
-  if (input->IsKeyPressed(SDL_SCANCODE_0)) {
-    renderSystem->SetScalingMode(ScalingMode::CONSTANT_SIZE);
-  }
-  if (input->IsKeyPressed(SDL_SCANCODE_9)) {
-    renderSystem->SetScalingMode(ScalingMode::PROPORTIONAL);
-  }
-
-  if (renderSystem->GetScalingMode() == ScalingMode::PROPORTIONAL) {
-    int w, h;
-    SDL_GetWindowSize(window, &w, &h);
-    renderSystem->screenHeight = (float)h;
-    renderSystem->screenWidth = (float)w;
-  }
-  // Clear screen to blue as required
-  renderSystem->SetBackgroundColor(0, 100, 200);  // Blue background
-  renderSystem->Clear();
-
-  // Render all visible entities
-  for (const auto &entity : entities) {
-    if (entity->rendering.isVisible) {
-      renderSystem->RenderEntity(entity);
-    }
-  }
-
-  renderSystem->Present();
-}
-
-void GameEngine::UpdateSystemsParallel(float deltaTime) {
-  // Clear the job queue for new frame
-  jobSystem.ClearJobs();
-  
-  // Add parallel system updates
-  jobSystem.AddJob([this]() {
-    input->Update();
-  });
-  
-  jobSystem.AddJob([this, deltaTime]() {
-    rootTimeline->Update(deltaTime);
-  });
-  
-  // Execute all engine system updates in parallel
-  jobSystem.ExecuteJobs();
-}
-
-void GameEngine::Shutdown() {
-  entityManager->ClearAllEntities();
-
-  if (renderer) {
-    SDL_DestroyRenderer(renderer);
-    renderer = nullptr;
-  }
-
-  if (window) {
-    SDL_DestroyWindow(window);
-    window = nullptr;
-  }
-
-  SDL_Quit();
-}
+// GameEngine.cpp
+// #include <memory>
+#include "GameEngine.h"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+using namespace std;
+
+// GameEngine Implementation
+#ifdef ENGINE_HEADLESS
+// Built without a display stack: every engine is headless
+GameEngine::GameEngine() : window(nullptr), renderer(nullptr), running(false), headlessMode(true), jobSystem(), frameGraph(jobSystem), frameSignal(jobSystem) {}
+GameEngine::GameEngine(bool) : window(nullptr), renderer(nullptr), running(false), headlessMode(true), jobSystem(), frameGraph(jobSystem), frameSignal(jobSystem) {}
+#else
+GameEngine::GameEngine() : window(nullptr), renderer(nullptr), running(false), headlessMode(false), jobSystem(), frameGraph(jobSystem), frameSignal(jobSystem) {}
+GameEngine::GameEngine(bool headless) : window(nullptr), renderer(nullptr), running(false), headlessMode(headless), jobSystem(), frameGraph(jobSystem), frameSignal(jobSystem) {}
+#endif
+
+
+GameEngine::~GameEngine() { Shutdown(); }
+
+bool GameEngine::Initialize(const char *title, int resx, int resy, float timeScale = 1.0f) {
+  // Initialize SDL; headless engines only need timers and logging, which
+  // work without any subsystem
+  if (!SDL_Init(headlessMode ? 0 : SDL_INIT_VIDEO)) {
+    SDL_Log("Failed to initialize SDL: %s", SDL_GetError());
+    return false;
+  }
+
+  if(timeScale < 0.5 || timeScale > 2.0) {
+    SDL_Log("Time scale must be between 0.5 and 2.0");
+    return false;
+  }
+
+  tickRate = 60.0f * timeScale;
+  winsizeX = resx;
+  winsizeY = resy;
+  if (!headlessMode) {
+    // Create window normally
+    window = SDL_CreateWindow(title, resx, resy, SDL_WINDOW_RESIZABLE);
+    if (!window) {
+      SDL_Log("Failed to create window: %s", SDL_GetError());
+      return false;
+    }
+
+    // Create renderer
+    renderer = SDL_CreateRenderer(window, nullptr);
+    if (!renderer) {
+      SDL_Log("Failed to create renderer: %s", SDL_GetError());
+      return false;
+    }
+  }
+  // Headless: no window and a null renderer everywhere. Rendering is a
+  // no-op and the AssetManager only reads texture metadata.
+
+  // Initialize systems
+  physics = std::make_unique<PhysicsSystem>(jobSystem);
+  input = std::make_unique<InputManager>();
+  collision = std::make_unique<CollisionSystem>();
+  collision->SetJobSystem(&jobSystem);
+  // Contacts are still applied in serial order, so results match the
+  // serial path; small passes stay serial (see kMinParallelPairs)
+  collision->SetParallelNarrowphase(true);
+  renderSystem = std::make_unique<RenderSystem>(renderer, resx, resy);
+  rootTimeline = std::make_unique<Timeline>(timeScale, nullptr);
+  entityManager = std::make_unique<EntityManager>();
+  assets = std::make_unique<AssetManager>(renderer, &jobSystem);
+
+  running = true;
+  return true;
+}
+
+void GameEngine::Run() {
+  if (threadedRendering && !headlessMode) {
+    RunSplit([this](float deltaTime) {
+      entityManager->FlushCommands();
+      std::vector<Entity *> &entities = entityManager->getEntityVectorRef();
+      frameGraph.Clear();
+      BuildFrameGraph(frameGraph, deltaTime / 1000.0, entities, false);
+      frameGraph.Execute();
+      frameSignal.Signal();
+    });
+    return;
+  }
+
+  SDL_Event event;
+  Uint32 lastTime = SDL_GetTicks();
+
+  while (running) {
+    // Calculate delta time
+    Uint32 currentTime = SDL_GetTicks();
+    float deltaTime = (float)(currentTime - lastTime);
+    lastTime = currentTime;
+
+    // Handle events
+    while (SDL_PollEvent(&event)) {
+      if (event.type == SDL_EVENT_QUIT ||
+          input->IsKeyPressed(SDL_SCANCODE_ESCAPE)) {
+        running = false;
+      }
+    }
+    // Structural changes recorded since the last frame land before any
+    // system starts iterating
+    entityManager->FlushCommands();
+    std::vector<Entity *> &entities = entityManager->getEntityVectorRef();
+
+    // Input/timeline, game update and render run as a dependency graph
+    frameGraph.Clear();
+    BuildFrameGraph(frameGraph, deltaTime / 1000.0, entities, !headlessMode);
+    frameGraph.Execute();
+    frameSignal.Signal();
+
+    float delay = std::max(0.0, 1000.0 / tickRate - deltaTime);
+    SDL_Delay(delay);
+  }
+}
+
+void GameEngine::RunSplit(const std::function<void(float)> &simTick) {
+  std::thread simThread([this, &simTick]() {
+    Uint32 lastTime = SDL_GetTicks();
+    uint64_t tick = 0;
+    while (running) {
+      Uint32 currentTime = SDL_GetTicks();
+      float deltaTime = (float)(currentTime - lastTime);
+      lastTime = currentTime;
+
+      simTick(deltaTime);
+
+      RenderSnapshot &snapshot = renderSnapshots.WriteBuffer();
+      snapshot.Capture(entityManager->GetView(EntityView::Visible), ++tick);
+      snapshot.camera = camera;
+      renderSnapshots.Publish();
+
+      float delay = std::max(0.0, 1000.0 / tickRate - deltaTime);
+      SDL_Delay(delay);
+    }
+  });
+
+  SDL_Event event;
+  while (running) {
+    while (SDL_PollEvent(&event)) {
+      if (event.type == SDL_EVENT_QUIT ||
+          input->IsKeyPressed(SDL_SCANCODE_ESCAPE)) {
+        running = false;
+      }
+    }
+    if (renderSnapshots.Acquire()) {
+      Render(renderSnapshots.ReadBuffer());
+    } else {
+      // Nothing new to draw yet; don't spin
+      SDL_Delay(1);
+    }
+  }
+  simThread.join();
+}
+
+void GameEngine::BuildFrameGraph(FrameGraph &graph, float deltaTime,
+                                 std::vector<Entity *> &entities,
+                                 bool renderStage) {
+  using namespace FrameResource;
+
+  graph.AddStage("input", None, Input, [this]() { input->Update(); });
+  graph.AddStage("timeline", None, Time,
+                 [this, deltaTime]() { rootTimeline->Update(deltaTime); });
+  graph.AddStage("entities", Input | Time, Entities | Transforms,
+                 [this, &entities]() {
+    for (auto &entity : entities) {
+      entity->Update(entity->timeline->getDeltaTime(), input.get(),
+                     entityManager.get());
+    }
+  });
+  graph.AddStage("physics", Time | Entities, Transforms, [this]() {
+    physics->ApplyPhysicsMultithreaded(
+        entityManager->GetViewRows(EntityView::Simulated));
+  });
+  // OnCollision callbacks may change gameplay state as well as positions
+  graph.AddStage("collision", None, Entities | Transforms | Contacts, [this]() {
+    collision->ProcessCollisions(
+        entityManager->GetView(EntityView::Collidable));
+  });
+  // SDL rendering must stay on the thread that owns the window. It draws the
+  // sprites captured at the end of the previous frame, so it only needs
+  // Input and overlaps the simulation stages above; the capture below is
+  // ordered after it (write-after-read) and after collision. The picture
+  // is one frame behind the simulation.
+  if (renderStage) {
+    graph.AddStage("render", Input | RenderCapture, Screen, [this]() {
+      Render(frameSnapshot);
+    }, true);
+    graph.AddStage("capture", Entities | Transforms, RenderCapture, [this]() {
+      frameSnapshot.Capture(entityManager->GetView(EntityView::Visible),
+                            frameSnapshot.tick + 1);
+      frameSnapshot.camera = camera;
+    });
+  }
+}
+
+void GameEngine::Update(float deltaTime, std::vector<Entity *> &entities) {
+  // Update all entities
+  for (auto &entity : entities) {
+    float entityDeltaTime = entity->timeline->getDeltaTime();
+    entity->Update(entityDeltaTime, input.get(), entityManager.get());
+
+  }
+  physics->ApplyPhysicsMultithreaded(
+      entityManager->GetViewRows(EntityView::Simulated));
+  // Process collisions
+  collision->ProcessCollisions(entityManager->GetView(EntityView::Collidable));
+}
+
+void GameEngine::Render(const std::vector<Entity *> &visibleEntities) {
+  if (!renderer) return;
+  renderSystem->SetCamera(camera);
+  beginFrame();
+  renderSystem->SubmitEntities(visibleEntities);
+  endFrame();
+}
+
+void GameEngine::Render(EntityView view) {
+  if (!renderer) return;
+  renderSystem->SetCamera(camera);
+  beginFrame();
+  renderSystem->SubmitEntities(entityManager->GetView(view),
+                               entityManager->GetViewRows(view));
+  endFrame();
+}
+
+void GameEngine::Render(const RenderSnapshot &snapshot) {
+  if (!renderer) return;
+  renderSystem->SetCamera(snapshot.camera);
+  beginFrame();
+  renderSystem->SubmitSprites(snapshot.sprites);
+  endFrame();
+}
+
+void GameEngine::beginFrame() {
+  if (input->IsKeyPressed(SDL_SCANCODE_0)) {
+    renderSystem->SetScalingMode(ScalingMode::CONSTANT_SIZE);
+  }
+  if (input->IsKeyPressed(SDL_SCANCODE_9)) {
+    renderSystem->SetScalingMode(ScalingMode::PROPORTIONAL);
+  }
+
+  if (renderSystem->GetScalingMode() == ScalingMode::PROPORTIONAL) {
+    int w, h;
+    SDL_GetWindowSize(window, &w, &h);
+    renderSystem->screenHeight = (float)h;
+    renderSystem->screenWidth = (float)w;
+  }
+  // Upload textures decoded in the background since the last frame
+  assets->ProcessUploads();
+
+  // Clear screen to blue as required
+  renderSystem->SetBackgroundColor(0, 100, 200);  // Blue background
+  renderSystem->Clear();
+
+  // Sprites submitted between here and endFrame are batched by layer, in
+  // submission order
+  renderSystem->BeginBatch();
+}
+
+void GameEngine::endFrame() {
+  renderSystem->FlushBatch();
+  renderSystem->Present();
+}
+
+void GameEngine::Shutdown() {
+  entityManager->ClearAllEntities();
+
+  // Textures must go before the renderer that created them, and pending
+  // decodes before the JobSystem they run on
+  assets.reset();
+
+  if (renderer) {
+    SDL_DestroyRenderer(renderer);
+    renderer = nullptr;
+  }
+
+  if (window) {
+    SDL_DestroyWindow(window);
+    window = nullptr;
+  }
+
+  SDL_Quit();
+}
@@ -1,66 +1,128 @@
-// GameEngine.h
-#pragma once
-#include <SDL3/SDL.h>
-
-#include <memory>
-
-#include "Collision/Collisions.h"
-#include "Entities/Entity.h"
-#include "Input/Input.h"
-#include "JobSystem.h"
-#include "Physics/Physics.h"
-#include "Render.h"
-#include "Timeline/Timeline.h"
-#include <vector>
-
-
-// Forward declarations
-
-// Core Engine Class
-class GameEngine {
- protected:
-  int winsizeX;
-  int winsizeY;
-  SDL_Window *window;
-  SDL_Renderer *renderer;
-  bool running;
-  bool headlessMode;
-  float tickRate;
-
-
-  std::unique_ptr<PhysicsSystem> physics;
-  std::unique_ptr<InputManager> input;
-  std::unique_ptr<CollisionSystem> collision;
-  std::unique_ptr<RenderSystem> renderSystem;
-  std::unique_ptr<Timeline> rootTimeline;
-  std::unique_ptr<EntityManager> entityManager;
-  JobSystem jobSystem;
-
-
- public:
-  GameEngine();
-  GameEngine(bool headless);
-  ~GameEngine();
-
-  bool Initialize(const char *title, int resx, int resy, float timeScale);
-  void Run();
-  void Shutdown();
-  void Render(std::vector<Entity *> &);
-  void Update(float deltaTime, std::vector<Entity *> &);
-  void UpdateSystemsParallel(float deltaTime);
-  EntityManager *GetEntityManager() { return entityManager.get(); }
-
-  // void AddEntity(Entity *entity);
-  // void RemoveEntity(Entity *entity);
-
-  PhysicsSystem *GetPhysics() const { return physics.get(); }
-  InputManager *GetInput() const { return input.get(); }
-  CollisionSystem *GetCollision() const { return collision.get(); }
-  RenderSystem *GetRenderSystem() const { return renderSystem.get(); }
-  SDL_Renderer *GetRenderer() const { return renderer; }
-
-  Timeline *GetRootTimeline() const { return rootTimeline.get(); }
-
-private:
-  void HandleEvents();
-};
+// GameEngine.h
+#pragma once
+#include <SDL3/SDL.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "AssetManager.h"
+#include "Collision/Collisions.h"
+#include "Entities/Entity.h"
+#include "FrameGraph.h"
+#include "Input/Input.h"
+#include "JobSystem.h"
+#include "Physics/Physics.h"
+#include "Render.h"
+#include "Task.h"
+#include "Timeline/Timeline.h"
+#include "TripleBuffer.h"
+#include <vector>
+
+
+// Forward declarations
+
+// Core Engine Class
+class GameEngine {
+ protected:
+  int winsizeX;
+  int winsizeY;
+  SDL_Window *window;
+  SDL_Renderer *renderer;
+  std::atomic<bool> running;
+  bool headlessMode;
+  bool threadedRendering = false;
+  float tickRate;
+
+
+  std::unique_ptr<PhysicsSystem> physics;
+  std::unique_ptr<InputManager> input;
+  std::unique_ptr<CollisionSystem> collision;
+  std::unique_ptr<RenderSystem> renderSystem;
+  std::unique_ptr<Timeline> rootTimeline;
+  std::unique_ptr<EntityManager> entityManager;
+  std::unique_ptr<AssetManager> assets;
+  JobSystem jobSystem;
+  FrameGraph frameGraph;
+  FrameSignal frameSignal;  // resumes coroutines awaiting the frame boundary
+
+  // Written by the simulation thread, drawn by the main thread
+  TripleBuffer<RenderSnapshot> renderSnapshots;
+
+  // Single-threaded mode: captured at the end of each frame graph and drawn
+  // by the next one, so rendering overlaps the simulation stages
+  RenderSnapshot frameSnapshot;
+
+  // Simulation-side view; copied into the RenderSystem (or the render
+  // snapshot) once per frame
+  Camera camera;
+
+  // Adds the engine's per-frame stages (input, timeline, entity update,
+  // physics, collision and, unless renderStage is false, render and
+  // capture) to the graph with their resource usage.
+  void BuildFrameGraph(FrameGraph &graph, float deltaTime,
+                       std::vector<Entity *> &entities,
+                       bool renderStage = true);
+
+  // Threaded mode main loop: simTick(deltaMs) runs on its own thread at
+  // tickRate and every tick ends with a render snapshot; the calling (main)
+  // thread pumps SDL events and draws the newest snapshot as fast as the
+  // display allows. Returns once running is cleared.
+  void RunSplit(const std::function<void(float)> &simTick);
+
+  // Per-frame render steps shared by Render and the snapshot path
+  void beginFrame();
+  void endFrame();
+
+
+ public:
+  GameEngine();
+  // Headless engines never initialize SDL video: no window, a null
+  // SDL_Renderer, Render() does nothing and texture loads are
+  // metadata-only. Builds configured with ENGINE_HEADLESS are always
+  // headless.
+  GameEngine(bool headless);
+  bool IsHeadless() const { return headlessMode; }
+  ~GameEngine();
+
+  bool Initialize(const char *title, int resx, int resy, float timeScale);
+  void Run();
+  void Shutdown();
+  // Draws the given entities in order; pass EntityView::Visible.
+  void Render(const std::vector<Entity *> &);
+  // Draws one of the entity manager's views, reading transforms from
+  // EntityColumns
+  void Render(EntityView view);
+  void Render(const RenderSnapshot &snapshot);
+
+  // Runs simulation and rendering on separate threads: the main thread keeps
+  // the window and SDL_Renderer (SDL requires it) and only draws snapshots,
+  // so a slow present or vsync wait no longer holds up simulation or
+  // networking. Entity updates and factories then run off the main thread
+  // and must load textures with LoadTextureAsync. Set before Run().
+  //
+  // Experimental and off by default: InputManager is not yet snapshotted, so
+  // the main thread's key checks race the simulation thread's Update().
+  void SetThreadedRendering(bool enabled) { threadedRendering = enabled; }
+  bool IsThreadedRendering() const { return threadedRendering; }
+  void Update(float deltaTime, std::vector<Entity *> &);
+  EntityManager *GetEntityManager() { return entityManager.get(); }
+
+  // void AddEntity(Entity *entity);
+  // void RemoveEntity(Entity *entity);
+
+  PhysicsSystem *GetPhysics() const { return physics.get(); }
+  InputManager *GetInput() const { return input.get(); }
+  CollisionSystem *GetCollision() const { return collision.get(); }
+  RenderSystem *GetRenderSystem() const { return renderSystem.get(); }
+  SDL_Renderer *GetRenderer() const { return renderer; }
+  AssetManager *GetAssets() const { return assets.get(); }
+  JobSystem *GetJobSystem() { return &jobSystem; }
+  FrameSignal *GetFrameSignal() { return &frameSignal; }
+
+  Timeline *GetRootTimeline() const { return rootTimeline.get(); }
+  Camera &GetCamera() { return camera; }
+
+private:
+  void HandleEvents();
+};
@@ -1,40 +1,251 @@
-#include "JobSystem.h"
-#include <cstddef>
-
-void JobSystem::worker(const JobQueue& jobs) {
-    while (true) {
-        size_t jobIndex = sharedData.nextJobIndex.fetch_add(1);
-        if (jobIndex >= jobs.size()) {
-            break;
-        }
-        jobs[jobIndex]();
-    }
-}
-
-void JobSystem::ExecuteJobs() {
-    if (jobQueue.empty()) {
-        return;
-    }
-    
-    // Reset job index
-    sharedData.nextJobIndex = 0;
-    
-    // Create worker threads
-    std::vector<std::thread> threads;
-    for (int i = 0; i < numThreads; ++i) {
-        threads.emplace_back(&JobSystem::worker, this, std::ref(jobQueue));
-    }
-    
-    // Wait for all threads to complete
-    for (auto& t : threads) {
-        t.join();
-    }
-}
-
-void JobSystem::ClearJobs() {
-    jobQueue.clear();
-}
-
-void JobSystem::AddJob(const Job& job) {
-    jobQueue.push_back(job);
-}
+#include "JobSystem.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+// Identifies the pool (and slot) the current thread works for, so nested
+// submissions land in the local deque instead of the injection queue.
+thread_local JobSystem* tlsOwner = nullptr;
+thread_local int tlsWorkerIndex = -1;
+
+uint32_t nextRandom(uint32_t& state) {
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+}  // namespace
+
+JobSystem::JobSystem(int numThreads) {
+    if (numThreads <= 0) {
+        int hardwareThreads = (int)std::thread::hardware_concurrency();
+        numThreads = std::max(1, hardwareThreads - 1);
+    }
+    this->numThreads = numThreads;
+
+    workerState.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        workerState.push_back(std::make_unique<Worker>());
+        workerState.back()->rngState = 0x9E3779B9u * (uint32_t)(i + 1);
+    }
+
+    workers.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sharedData.poolMutex);
+        sharedData.shuttingDown = true;
+    }
+    sharedData.workAvailable.notify_all();
+
+    for (auto& t : workers) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+
+    // Drop anything that was submitted but never picked up
+    for (JobTask* task : sharedData.injectionQueue) {
+        delete task;
+    }
+    for (auto& worker : workerState) {
+        JobTask* task = nullptr;
+        while (worker->deque.Pop(task)) {
+            delete task;
+        }
+    }
+}
+
+void JobSystem::Submit(Job job, JobCounter* counter) {
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    JobTask* task = new JobTask{std::move(job), counter};
+
+    if (tlsOwner == this) {
+        workerState[tlsWorkerIndex]->deque.Push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(sharedData.injectionMutex);
+        sharedData.injectionQueue.push_back(task);
+    }
+    sharedData.queuedTasks.fetch_add(1);
+    wakeOne();
+}
+
+void JobSystem::wakeOne() {
+    if (sharedData.sleepingWorkers.load() > 0) {
+        // Taking the lock orders us after a worker that is about to wait
+        { std::lock_guard<std::mutex> lock(sharedData.poolMutex); }
+        sharedData.workAvailable.notify_one();
+    }
+}
+
+JobTask* JobSystem::findTask(int workerIndex) {
+    JobTask* task = nullptr;
+
+    // 1. Own deque (LIFO, cache-warm)
+    if (workerIndex >= 0 && workerState[workerIndex]->deque.Pop(task)) {
+        return task;
+    }
+
+    // 2. Work injected from outside the pool (FIFO)
+    {
+        std::lock_guard<std::mutex> lock(sharedData.injectionMutex);
+        if (!sharedData.injectionQueue.empty()) {
+            task = sharedData.injectionQueue.front();
+            sharedData.injectionQueue.pop_front();
+            return task;
+        }
+    }
+
+    // 3. Steal from a random victim, then sweep the rest
+    const int count = (int)workerState.size();
+    if (count == 0) {
+        return nullptr;
+    }
+    thread_local uint32_t externalRng = 0x2545F491u;
+    uint32_t& rng = workerIndex >= 0 ? workerState[workerIndex]->rngState : externalRng;
+    const int start = (int)(nextRandom(rng) % (uint32_t)count);
+    for (int i = 0; i < count; ++i) {
+        int victim = (start + i) % count;
+        if (victim == workerIndex) {
+            continue;
+        }
+        if (workerState[victim]->deque.Steal(task)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::runTask(JobTask* task) {
+    sharedData.queuedTasks.fetch_sub(1);
+    task->job();
+    // seq_cst pairs with the sleepingWorkers check in WakeWaiters
+    if (task->counter && task->counter->pending.fetch_sub(1) == 1) {
+        WakeWaiters();
+    }
+    delete task;
+}
+
+bool JobSystem::tryRunOne(int workerIndex) {
+    JobTask* task = findTask(workerIndex);
+    if (!task) {
+        return false;
+    }
+    runTask(task);
+    return true;
+}
+
+void JobSystem::workerLoop(int index) {
+    tlsOwner = this;
+    tlsWorkerIndex = index;
+
+    while (true) {
+        if (tryRunOne(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sharedData.poolMutex);
+        sharedData.sleepingWorkers.fetch_add(1);
+        sharedData.workAvailable.wait(lock, [this] {
+            return sharedData.shuttingDown || sharedData.queuedTasks.load() > 0;
+        });
+        sharedData.sleepingWorkers.fetch_sub(1);
+        if (sharedData.shuttingDown) {
+            return;
+        }
+    }
+}
+
+void JobSystem::WaitForCounter(JobCounter& counter) {
+    const int workerIndex = (tlsOwner == this) ? tlsWorkerIndex : -1;
+    int idleSpins = 0;
+    while (!counter.IsDone()) {
+        if (tryRunOne(workerIndex)) {
+            idleSpins = 0;
+        } else if (++idleSpins < kSpinsBeforePark) {
+            std::this_thread::yield();
+        } else {
+            // The remaining jobs are running elsewhere; don't burn a core
+            idleSpins = 0;
+            ParkUntil([&counter] { return counter.pending.load() == 0; });
+        }
+    }
+}
+
+void JobSystem::ParkUntil(const std::function<bool()>& ready) {
+    std::unique_lock<std::mutex> lock(sharedData.poolMutex);
+    // Counted as sleeping so Submit's wakeOne and WakeWaiters notify us
+    sharedData.sleepingWorkers.fetch_add(1);
+    sharedData.workAvailable.wait(lock, [this, &ready] {
+        return sharedData.shuttingDown || sharedData.queuedTasks.load() > 0 || ready();
+    });
+    sharedData.sleepingWorkers.fetch_sub(1);
+}
+
+void JobSystem::WakeWaiters() {
+    if (sharedData.sleepingWorkers.load() > 0) {
+        // Taking the lock orders us after a waiter that is about to sleep
+        { std::lock_guard<std::mutex> lock(sharedData.poolMutex); }
+        sharedData.workAvailable.notify_all();
+    }
+}
+
+bool JobSystem::RunOneJob() {
+    return tryRunOne((tlsOwner == this) ? tlsWorkerIndex : -1);
+}
+
+void JobSystem::drainJobs() {
+    while (true) {
+        size_t jobIndex = sharedData.nextJobIndex.fetch_add(1);
+        if (jobIndex >= jobQueue.size()) {
+            break;
+        }
+        jobQueue[jobIndex]();
+    }
+}
+
+void JobSystem::ExecuteJobs() {
+    if (jobQueue.empty()) {
+        return;
+    }
+    
+    // Reset job index
+    sharedData.nextJobIndex = 0;
+
+    // One drain task per worker that could usefully help; the calling thread
+    // works on the batch too instead of idling
+    JobCounter batch;
+    size_t helpers = std::min(workers.size(), jobQueue.size() - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        Submit([this]() { drainJobs(); }, &batch);
+    }
+    drainJobs();
+    
+    // Wait for all helpers to finish their last job
+    WaitForCounter(batch);
+}
+
+GrainTuner* JobSystem::grainTunerFor(std::type_index site) {
+    std::lock_guard<std::mutex> lock(tunerMutex);
+    return &grainTuners[site];
+}
+
+void JobSystem::recordGrain(GrainTuner* tuner, size_t items, double busyNs) {
+    std::lock_guard<std::mutex> lock(tunerMutex);
+    tuner->Record(items, busyNs);
+}
+
+void JobSystem::ClearJobs() {
+    jobQueue.clear();
+}
+
+void JobSystem::AddJob(const Job& job) {
+    jobQueue.push_back(job);
+}
@@ -1,22 +1,188 @@
-#pragma once
-#include <functional>
-#include <vector>
-#include <thread>
-#include "SharedData.h"
-
-using Job = std::function<void()>;
-using JobQueue = std::vector<Job>;
-
-class JobSystem {
-public:
-    JobSystem(int numThreads) : numThreads(numThreads) {}
-    void ExecuteJobs();  
-    void ClearJobs();    
-    void AddJob(const Job& job); 
-    
-private:
-    void worker(const JobQueue& jobs);
-    int numThreads;
-    SharedData sharedData;
-    JobQueue jobQueue; 
-};
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include <thread>
+#include "SharedData.h"
+#include "WorkStealingDeque.h"
+
+using Job = std::function<void()>;
+using JobQueue = std::vector<Job>;
+
+// Tracks outstanding jobs submitted against it; WaitForCounter blocks until it
+// drops back to zero.
+struct JobCounter {
+    std::atomic<int> pending{0};
+
+    bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+struct JobTask {
+    Job job;
+    JobCounter* counter;
+};
+
+// Per-call-site estimate of how long one ParallelFor item takes, used to pick
+// a grain size that keeps each chunk around targetChunkNs of work.
+struct GrainTuner {
+    static constexpr double targetChunkNs = 20000.0;
+    double nsPerItem = 0.0;  // 0 until the first measurement
+
+    size_t SuggestGrain(size_t count, size_t lanes) const {
+        if (nsPerItem <= 0.0) {
+            // No measurement yet: a few chunks per lane so stealing can balance
+            return std::max<size_t>(1, count / (lanes * 4));
+        }
+        size_t grain = (size_t)(targetChunkNs / nsPerItem);
+        return std::clamp<size_t>(grain, 1, count);
+    }
+
+    void Record(size_t items, double busyNs) {
+        if (items == 0) return;
+        double sample = busyNs / (double)items;
+        nsPerItem = (nsPerItem <= 0.0) ? sample : nsPerItem * 0.75 + sample * 0.25;
+    }
+};
+
+// Persistent work-stealing worker pool.
+//
+// Every worker owns a Chase-Lev deque. Jobs submitted from inside a job go to
+// the submitting worker's deque; jobs from other threads go to a shared
+// injection queue. Idle workers steal from random victims and park on a
+// condition variable once nothing is left anywhere.
+//
+// The flat AddJob/ExecuteJobs batch API is kept and runs on the same pool.
+class JobSystem {
+public:
+    // numThreads <= 0 sizes the pool to the hardware concurrency (the calling
+    // thread counts as one lane, so hardware_concurrency - 1 workers are spawned).
+    explicit JobSystem(int numThreads = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void ExecuteJobs();  
+    void ClearJobs();    
+    void AddJob(const Job& job); 
+
+    // Schedules a job; safe to call from any thread, including from inside a
+    // running job. If counter is given it is incremented now and decremented
+    // when the job finishes.
+    void Submit(Job job, JobCounter* counter = nullptr);
+
+    // Runs queued jobs on the calling thread until the counter reaches zero,
+    // so waiting from inside a job never deadlocks the pool. When there is
+    // nothing to run it spins briefly, then sleeps until the counter
+    // finishes or new work is submitted.
+    void WaitForCounter(JobCounter& counter);
+
+    // Idle rounds (nothing to run) a waiter yields through before parking
+    static constexpr int kSpinsBeforePark = 64;
+
+    // Sleeps until ready() holds or a job is queued. ready() is evaluated
+    // under the pool lock, so whoever makes it true must call WakeWaiters()
+    // afterwards. Counters passed to Submit do this automatically.
+    void ParkUntil(const std::function<bool()>& ready);
+    void WakeWaiters();
+
+    // Runs at most one queued job on the calling thread. Returns false if
+    // there was nothing to run.
+    bool RunOneJob();
+
+    // Calls fn(i) for every i in [begin, end). The range is cut into chunks of
+    // grainSize items that the pool claims one at a time; nothing is allocated
+    // per item. Pass kAutoGrain to size chunks from the measured per-item cost
+    // of previous calls at the same call site.
+    static constexpr size_t kAutoGrain = 0;
+
+    template <typename Fn>
+    void ParallelFor(size_t begin, size_t end, size_t grainSize, Fn&& fn);
+
+    int GetNumThreads() const { return numThreads; }
+    
+private:
+    struct Worker {
+        WorkStealingDeque<JobTask*> deque;
+        uint32_t rngState = 0;
+    };
+
+    void workerLoop(int index);
+    void drainJobs();
+    bool tryRunOne(int workerIndex);
+    JobTask* findTask(int workerIndex);
+    void runTask(JobTask* task);
+    void wakeOne();
+    GrainTuner* grainTunerFor(std::type_index site);
+    void recordGrain(GrainTuner* tuner, size_t items, double busyNs);
+
+    int numThreads;
+    SharedData sharedData;
+    JobQueue jobQueue; 
+    std::vector<std::unique_ptr<Worker>> workerState;
+    std::vector<std::thread> workers;
+
+    std::mutex tunerMutex;
+    std::unordered_map<std::type_index, GrainTuner> grainTuners;
+};
+
+template <typename Fn>
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize, Fn&& fn) {
+    if (begin >= end) {
+        return;
+    }
+    using clock = std::chrono::steady_clock;
+    const size_t count = end - begin;
+    const size_t lanes = workers.size() + 1;
+
+    // Each lambda type is a distinct call site, so it keys the tuner
+    GrainTuner* tuner = nullptr;
+    if (grainSize == kAutoGrain) {
+        tuner = grainTunerFor(std::type_index(typeid(Fn)));
+        std::lock_guard<std::mutex> lock(tunerMutex);
+        grainSize = tuner->SuggestGrain(count, lanes);
+    }
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<int64_t> busyNs{0};
+    auto runChunks = [&]() {
+        auto start = clock::now();
+        while (true) {
+            size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount) {
+                break;
+            }
+            size_t lo = begin + chunk * grainSize;
+            size_t hi = std::min(lo + grainSize, end);
+            for (size_t i = lo; i < hi; ++i) {
+                fn(i);
+            }
+        }
+        if (tuner) {
+            busyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 clock::now() - start).count(),
+                             std::memory_order_relaxed);
+        }
+    };
+
+    // Helpers capture only a pointer to runChunks, which fits in
+    // std::function's small buffer
+    JobCounter counter;
+    size_t helpers = std::min(workers.size(), chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        Submit([&runChunks]() { runChunks(); }, &counter);
+    }
+    runChunks();
+    WaitForCounter(counter);
+
+    if (tuner) {
+        recordGrain(tuner, count, (double)busyNs.load());
+    }
+}
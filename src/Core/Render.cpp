@@ -1,118 +1,353 @@
-#include "Render.h"
-
-#include <SDL3/SDL.h>
-#include "Math/vec2.h"
-RenderSystem::RenderSystem(SDL_Renderer *renderer)
-    : renderer(renderer),
-      currentMode(ScalingMode::CONSTANT_SIZE),
-      baseWidth(1920.0f),
-      baseHeight(1080.0f),
-      screenWidth(baseWidth),
-      screenHeight(baseHeight) {}
-
-RenderSystem::RenderSystem(SDL_Renderer *renderer, int width, int height)
-    : renderer(renderer),
-      currentMode(ScalingMode::CONSTANT_SIZE),
-      baseWidth((float)width),
-      baseHeight((float)height),
-      screenWidth(baseWidth),
-      screenHeight(baseHeight) {}
-
-void RenderSystem::SetScalingMode(ScalingMode mode) {
-  currentMode = mode;
-  SDL_Log("Scaling mode changed to: %s", mode == ScalingMode::CONSTANT_SIZE
-                                             ? "Constant Size"
-                                             : "Proportional");
-}
-
-void RenderSystem::ToggleScalingMode() {
-  currentMode = (currentMode == ScalingMode::CONSTANT_SIZE)
-                    ? ScalingMode::PROPORTIONAL
-                    : ScalingMode::CONSTANT_SIZE;
-  SDL_Log("Scaling mode toggled to: %s",
-          currentMode == ScalingMode::CONSTANT_SIZE ? "Constant Size"
-                                                    : "Proportional");
-}
-
-void RenderSystem::RenderEntity(const Entity *entity) {
-  if (!entity) return;
-  // Use your entity's texture member directly to match your current codebase.
-  // If you have an accessor, replace with: SDL_Texture* tex =
-  // entity->GetTexture();
-  auto it = entity->rendering.textures.find(entity->rendering.currentTextureState);
-  if (it == entity->rendering.textures.end()) {
-    return;
-  }
-  SDL_Texture *tex = it->second.sheet;
-  if (!tex)
-    return;
-
-  SDL_FRect dst = CalculateRenderRect(entity);
-
-  SDL_FRect src;
-  const SDL_FRect *psrc = nullptr;
-  if (entity->GetSourceRect(src)) {
-    psrc = &src;  // draw the current frame
-  }
-  SDL_RenderTexture(renderer, tex, psrc, &dst);
-}
-
-void RenderSystem::RenderEntity(const Entity *entity,
-                                const SDL_FRect *sourceRect) {
-  if (!entity)
-    return;
-  auto it = entity->rendering.textures.find(entity->rendering.currentTextureState);
-  if (it == entity->rendering.textures.end())
-    return;
-  SDL_Texture *tex = it->second.sheet;
-  if (!tex)
-    return;
-
-  SDL_FRect dst = CalculateRenderRect(entity);
-  SDL_RenderTexture(renderer, tex, sourceRect, &dst);
-}
-
-SDL_FRect RenderSystem::CalculateRenderRect(const Entity *entity) {
-  vec2 pos = entity->position;
-  vec2 dims = entity->dimensions;
-
-  // apply camera offset
-  pos.x += entity->rendering.offSetX;
-  pos.y += entity->rendering.offSetY;
-
-  if (currentMode == ScalingMode::PROPORTIONAL) {
-    const float scaleX = screenWidth / baseWidth;
-    const float scaleY = screenHeight / baseHeight;
-    vec2 scale = {.x = scaleX, .y = scaleY};
-    pos = mulv(pos, scale);
-    dims = mulv(dims, scale);
-  }
-
-  SDL_FRect rect = {.x = pos.x, .y = pos.y, .w = dims.x, .h = dims.y};
-
-  return (SDL_FRect)rect;
-}
-
-void RenderSystem::SetBackgroundColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-  SDL_SetRenderDrawColor(renderer, r, g, b, a);
-}
-
-void RenderSystem::Clear() { SDL_RenderClear(renderer); }
-
-void RenderSystem::Present() { SDL_RenderPresent(renderer); }
-
-SDL_Texture *LoadTexture(SDL_Renderer *renderer, const char *path) {
-  SDL_Surface *surface = SDL_LoadBMP(path);
-  if (!surface) {
-    return nullptr;
-  }
-
-  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-  SDL_DestroySurface(surface);
-
-  if (!texture) {
-    return nullptr;
-  }
-
-  return texture;
+#include "Render.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstddef>
+#include "Math/vec2.h"
+
+static_assert(sizeof(RectF) == sizeof(SDL_FRect) &&
+                  offsetof(RectF, x) == offsetof(SDL_FRect, x) &&
+                  offsetof(RectF, y) == offsetof(SDL_FRect, y) &&
+                  offsetof(RectF, w) == offsetof(SDL_FRect, w) &&
+                  offsetof(RectF, h) == offsetof(SDL_FRect, h),
+              "RectF must match SDL_FRect so batches can be written in place");
+
+RenderSystem::RenderSystem(SDL_Renderer *renderer)
+    : renderer(renderer),
+      currentMode(ScalingMode::CONSTANT_SIZE),
+      baseWidth(1920.0f),
+      baseHeight(1080.0f),
+      screenWidth(baseWidth),
+      screenHeight(baseHeight) {}
+
+RenderSystem::RenderSystem(SDL_Renderer *renderer, int width, int height)
+    : renderer(renderer),
+      currentMode(ScalingMode::CONSTANT_SIZE),
+      baseWidth((float)width),
+      baseHeight((float)height),
+      screenWidth(baseWidth),
+      screenHeight(baseHeight) {}
+
+void RenderSystem::SetScalingMode(ScalingMode mode) {
+  currentMode = mode;
+  SDL_Log("Scaling mode changed to: %s", mode == ScalingMode::CONSTANT_SIZE
+                                             ? "Constant Size"
+                                             : "Proportional");
+}
+
+void RenderSystem::ToggleScalingMode() {
+  currentMode = (currentMode == ScalingMode::CONSTANT_SIZE)
+                    ? ScalingMode::PROPORTIONAL
+                    : ScalingMode::CONSTANT_SIZE;
+  SDL_Log("Scaling mode toggled to: %s",
+          currentMode == ScalingMode::CONSTANT_SIZE ? "Constant Size"
+                                                    : "Proportional");
+}
+
+void RenderSystem::RenderEntity(const Entity *entity) {
+  if (!entity) return;
+  // Use your entity's texture member directly to match your current codebase.
+  // If you have an accessor, replace with: SDL_Texture* tex =
+  // entity->GetTexture();
+  auto it = entity->rendering.textures.find(entity->rendering.currentTextureState);
+  if (it == entity->rendering.textures.end()) {
+    return;
+  }
+  SDL_Texture *tex = SheetFor(it->second);
+  if (!tex)
+    return;
+
+  SDL_FRect dst = CalculateRenderRect(entity);
+
+  SDL_FRect src;
+  const SDL_FRect *psrc = nullptr;
+  if (entity->GetSourceRect(src)) {
+    psrc = &src;  // draw the current frame
+  }
+  SDL_FRect mapped;
+  psrc = MapSourceRect(it->second, psrc, mapped);
+  SDL_RenderTexture(renderer, tex, psrc, &dst);
+}
+
+void RenderSystem::RenderEntity(const Entity *entity,
+                                const SDL_FRect *sourceRect) {
+  if (!entity)
+    return;
+  auto it = entity->rendering.textures.find(entity->rendering.currentTextureState);
+  if (it == entity->rendering.textures.end())
+    return;
+  SDL_Texture *tex = SheetFor(it->second);
+  if (!tex)
+    return;
+
+  SDL_FRect dst = CalculateRenderRect(entity);
+  SDL_FRect mapped;
+  SDL_RenderTexture(renderer, tex, MapSourceRect(it->second, sourceRect, mapped), &dst);
+}
+
+void RenderSystem::BeginBatch() {
+  sprites.clear();
+  culledCount = 0;
+
+  // Screen rects are in output pixels in both scaling modes
+  int w = 0, h = 0;
+  if (SDL_GetCurrentRenderOutputSize(renderer, &w, &h) && w > 0 && h > 0) {
+    viewport = {0.0f, 0.0f, (float)w, (float)h};
+  } else {
+    viewport = {0.0f, 0.0f, screenWidth, screenHeight};
+  }
+}
+
+bool RenderSystem::culled(const SDL_FRect &dst) const {
+  return dst.x >= viewport.x + viewport.w || dst.x + dst.w <= viewport.x ||
+         dst.y >= viewport.y + viewport.h || dst.y + dst.h <= viewport.y;
+}
+
+void RenderSystem::SubmitEntity(const Entity *entity) {
+  if (!entity) return;
+  SDL_FRect dst = CalculateRenderRect(entity);
+  if (culled(dst)) {
+    culledCount++;
+    return;
+  }
+
+  auto it = entity->rendering.textures.find(entity->rendering.currentTextureState);
+  if (it == entity->rendering.textures.end()) {
+    return;
+  }
+  SDL_FRect local;
+  const SDL_FRect *psrc = entity->GetSourceRect(local) ? &local : nullptr;
+  submit(it->second, psrc, dst, entity->rendering.layer);
+}
+
+void RenderSystem::SubmitSprite(const RenderSprite &sprite) {
+  SDL_FRect dst = CalculateRenderRect(sprite.position, sprite.dimensions);
+  if (culled(dst)) {
+    culledCount++;
+    return;
+  }
+  submit(sprite.texture, sprite.hasSource ? &sprite.source : nullptr, dst,
+         sprite.layer);
+}
+
+void RenderSystem::SubmitEntities(const std::vector<Entity *> &entities) {
+  positions.clear();
+  dimensions.clear();
+  for (const Entity *entity : entities) {
+    positions.push_back(entity->position);
+    dimensions.push_back(entity->dimensions);
+  }
+  transformBatch();
+  submitEntities(entities);
+}
+
+void RenderSystem::SubmitEntities(const std::vector<Entity *> &entities,
+                                  const std::vector<uint32_t> &rows) {
+  positions.clear();
+  dimensions.clear();
+  for (uint32_t row : rows) {
+    positions.push_back(EntityColumns::Position(row));
+    dimensions.push_back(EntityColumns::Dimensions(row));
+  }
+  transformBatch();
+  submitEntities(entities);
+}
+
+void RenderSystem::submitEntities(const std::vector<Entity *> &entities) {
+  for (size_t i = 0; i < entities.size(); ++i) {
+    const Entity *entity = entities[i];
+    if (culled(rects[i])) {
+      culledCount++;
+      continue;
+    }
+    auto it = entity->rendering.textures.find(entity->rendering.currentTextureState);
+    if (it == entity->rendering.textures.end()) {
+      continue;
+    }
+    SDL_FRect local;
+    const SDL_FRect *psrc = entity->GetSourceRect(local) ? &local : nullptr;
+    submit(it->second, psrc, rects[i], entity->rendering.layer);
+  }
+}
+
+void RenderSystem::SubmitSprites(const std::vector<RenderSprite> &batch) {
+  positions.clear();
+  dimensions.clear();
+  for (const RenderSprite &sprite : batch) {
+    positions.push_back(sprite.position);
+    dimensions.push_back(sprite.dimensions);
+  }
+  transformBatch();
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (culled(rects[i])) {
+      culledCount++;
+      continue;
+    }
+    submit(batch[i].texture, batch[i].hasSource ? &batch[i].source : nullptr,
+           rects[i], batch[i].layer);
+  }
+}
+
+void RenderSystem::transformBatch() {
+  rects.resize(positions.size());
+  TransformRects(positions.data(), dimensions.data(), positions.size(),
+                 viewTransform(), reinterpret_cast<RectF *>(rects.data()));
+}
+
+void RenderSystem::submit(const Texture &texture, const SDL_FRect *local,
+                          const SDL_FRect &dst, int layer) {
+  SDL_Texture *tex = SheetFor(texture);
+  if (!tex)
+    return;
+
+  SDL_FRect mapped;
+  const SDL_FRect *psrc = MapSourceRect(texture, local, mapped);
+
+  SpriteInstance sprite;
+  sprite.texture = tex;
+  sprite.src = psrc ? *psrc : SDL_FRect{0, 0, 0, 0};
+  sprite.dst = dst;
+  sprite.wholeTexture = psrc == nullptr;
+  sprite.layer = layer;
+  sprite.order = (uint32_t)sprites.size();
+  sprites.push_back(sprite);
+}
+
+void RenderSnapshot::Capture(const std::vector<Entity *> &entities, uint64_t tick) {
+  this->tick = tick;
+  sprites.clear();
+  for (const Entity *entity : entities) {
+    auto it = entity->rendering.textures.find(entity->rendering.currentTextureState);
+    if (it == entity->rendering.textures.end()) {
+      continue;
+    }
+    RenderSprite sprite;
+    sprite.texture = it->second;
+    sprite.hasSource = entity->GetSourceRect(sprite.source);
+    sprite.position = entity->position;
+    sprite.dimensions = entity->dimensions;
+    sprite.layer = entity->rendering.layer;
+    sprites.push_back(std::move(sprite));
+  }
+}
+
+void RenderSystem::FlushBatch() {
+  // Never reorder by texture: pointer order is arbitrary, so overlapping
+  // sprites with different textures would stack differently run to run
+  std::sort(sprites.begin(), sprites.end(),
+            [](const SpriteInstance &a, const SpriteInstance &b) {
+              if (a.layer != b.layer) return a.layer < b.layer;
+              return a.order < b.order;
+            });
+
+  lastDrawCalls = 0;
+  lastSpriteCount = sprites.size();
+  lastCulledCount = culledCount;
+  size_t runStart = 0;
+  for (size_t i = 1; i <= sprites.size(); ++i) {
+    if (i == sprites.size() || sprites[i].texture != sprites[runStart].texture) {
+      drawRun(runStart, i);
+      runStart = i;
+    }
+  }
+  sprites.clear();
+}
+
+void RenderSystem::drawRun(size_t begin, size_t end) {
+  if (begin >= end) return;
+  SDL_Texture *tex = sprites[begin].texture;
+  float texW = 1.0f, texH = 1.0f;
+  SDL_GetTextureSize(tex, &texW, &texH);
+  const float invW = texW > 0.0f ? 1.0f / texW : 0.0f;
+  const float invH = texH > 0.0f ? 1.0f / texH : 0.0f;
+
+  vertices.clear();
+  indices.clear();
+  const SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+  for (size_t i = begin; i < end; ++i) {
+    const SpriteInstance &s = sprites[i];
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (!s.wholeTexture) {
+      u0 = s.src.x * invW;
+      v0 = s.src.y * invH;
+      u1 = (s.src.x + s.src.w) * invW;
+      v1 = (s.src.y + s.src.h) * invH;
+    }
+    const float x0 = s.dst.x, y0 = s.dst.y;
+    const float x1 = s.dst.x + s.dst.w, y1 = s.dst.y + s.dst.h;
+
+    int base = (int)vertices.size();
+    vertices.push_back({{x0, y0}, white, {u0, v0}});
+    vertices.push_back({{x1, y0}, white, {u1, v0}});
+    vertices.push_back({{x1, y1}, white, {u1, v1}});
+    vertices.push_back({{x0, y1}, white, {u0, v1}});
+    indices.insert(indices.end(),
+                   {base, base + 1, base + 2, base, base + 2, base + 3});
+  }
+  SDL_RenderGeometry(renderer, tex, vertices.data(), (int)vertices.size(),
+                     indices.data(), (int)indices.size());
+  lastDrawCalls++;
+}
+
+SDL_FRect RenderSystem::CalculateRenderRect(const Entity *entity) {
+  return CalculateRenderRect(entity->position, entity->dimensions);
+}
+
+RectTransform RenderSystem::viewTransform() const {
+  // world -> view, then scaling
+  RectTransform transform;
+  transform.translate = neg(camera.position);
+  if (currentMode == ScalingMode::PROPORTIONAL) {
+    transform.scale = {.x = screenWidth / baseWidth, .y = screenHeight / baseHeight};
+  }
+  return transform;
+}
+
+SDL_FRect RenderSystem::CalculateRenderRect(vec2 pos, vec2 dims) {
+  const RectTransform transform = viewTransform();
+  pos = mulv(add(pos, transform.translate), transform.scale);
+  dims = mulv(dims, transform.scale);
+
+  SDL_FRect rect = {.x = pos.x, .y = pos.y, .w = dims.x, .h = dims.y};
+
+  return (SDL_FRect)rect;
+}
+
+void RenderSystem::SetBackgroundColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+  SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+void RenderSystem::Clear() { SDL_RenderClear(renderer); }
+
+void RenderSystem::Present() { SDL_RenderPresent(renderer); }
+
+SDL_Texture *SheetFor(const Texture &texture) {
+  // Shared assets may still be loading or be re-uploaded, so go through the
+  // handle rather than the pointer captured when the entity was built
+  return texture.asset ? texture.asset->Current() : texture.sheet;
+}
+
+const SDL_FRect *MapSourceRect(const Texture &texture, const SDL_FRect *local,
+                               SDL_FRect &storage) {
+  if (!texture.asset) {
+    return local;
+  }
+  return texture.asset->MapRect(local, storage) ? &storage : nullptr;
+}
+
+SDL_Texture *LoadTexture(SDL_Renderer *renderer, const char *path) {
+  SDL_Surface *surface = SDL_LoadBMP(path);
+  if (!surface) {
+    return nullptr;
+  }
+
+  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+  SDL_DestroySurface(surface);
+
+  if (!texture) {
+    return nullptr;
+  }
+
+  return texture;
 }
\ No newline at end of file
@@ -1,43 +1,149 @@
-#pragma once
-#include <SDL3/SDL.h>
-
-#include "Entities/Entity.h"
-
-enum class ScalingMode {
-  CONSTANT_SIZE,  // Pixel-based
-  PROPORTIONAL    // Percentage-based
-};
-
-class RenderSystem {
- private:
-  SDL_Renderer *renderer;
-  ScalingMode currentMode;
-
-  float baseWidth, baseHeight;  // Reference resolution for proportional scaling
-
- public:
-  float screenWidth, screenHeight;
-
-  explicit RenderSystem(SDL_Renderer *renderer);
-
-  RenderSystem(SDL_Renderer *renderer, int width, int height);
-
-  void SetScalingMode(ScalingMode mode);
-  ScalingMode GetScalingMode() const { return currentMode; }
-  void ToggleScalingMode();
-
-  // Auto: asks the entity for a source rect (frame) via GetSourceRect(...)
-  void RenderEntity(const Entity *entity);
-
-  // Manual: render with an explicit source rect (or nullptr for full texture)
-  void RenderEntity(const Entity *entity, const SDL_FRect *sourceRect);
-
-  void SetBackgroundColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);
-  void Clear();
-  void Present();
-
- private:
-  SDL_FRect CalculateRenderRect(const Entity *entity);
-};
-
-SDL_Texture *LoadTexture(SDL_Renderer *renderer, const char *path);
+#pragma once
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Entities/Entity.h"
+#include "Math/TransformBatch.h"
+
+// One quad queued for batched rendering; src is in texture pixels.
+struct SpriteInstance {
+  SDL_Texture *texture;
+  SDL_FRect src;
+  SDL_FRect dst;
+  bool wholeTexture;  // src unused, sample the full texture
+  int layer;
+  uint32_t order;  // submission order, keeps sorting stable
+};
+
+// Immutable copy of what one entity looks like this tick, so a frame can be
+// drawn while the simulation moves on (see GameEngine::SetThreadedRendering).
+struct RenderSprite {
+  Texture texture;  // holds the shared asset, so it outlives the entity
+  bool hasSource;
+  SDL_FRect source;  // sheet-local, from Entity::GetSourceRect
+  vec2 position;
+  vec2 dimensions;
+  int layer;
+};
+
+// View into the world. Applied once per frame by RenderSystem as a view
+// transform: screen = (world - position), then the scaling mode.
+struct Camera {
+  vec2 position = {0.0f, 0.0f};
+};
+
+struct RenderSnapshot {
+  std::vector<RenderSprite> sprites;
+  Camera camera;
+  uint64_t tick = 0;
+
+  // Replaces the contents with the given (visible) entities. Runs on the
+  // simulation thread; calls each entity's GetSourceRect.
+  void Capture(const std::vector<Entity *> &entities, uint64_t tick);
+};
+
+enum class ScalingMode {
+  CONSTANT_SIZE,  // Pixel-based
+  PROPORTIONAL    // Percentage-based
+};
+
+class RenderSystem {
+ private:
+  SDL_Renderer *renderer;
+  ScalingMode currentMode;
+
+  float baseWidth, baseHeight;  // Reference resolution for proportional scaling
+
+ public:
+  float screenWidth, screenHeight;
+
+  explicit RenderSystem(SDL_Renderer *renderer);
+
+  RenderSystem(SDL_Renderer *renderer, int width, int height);
+
+  // Camera used for everything drawn until it is changed again
+  void SetCamera(const Camera &camera) { this->camera = camera; }
+  const Camera &GetCamera() const { return camera; }
+
+  void SetScalingMode(ScalingMode mode);
+  ScalingMode GetScalingMode() const { return currentMode; }
+  void ToggleScalingMode();
+
+  // Auto: asks the entity for a source rect (frame) via GetSourceRect(...)
+  void RenderEntity(const Entity *entity);
+
+  // Manual: render with an explicit source rect (or nullptr for full texture)
+  void RenderEntity(const Entity *entity, const SDL_FRect *sourceRect);
+
+  // Batched path: queue sprites between BeginBatch and FlushBatch, which
+  // orders them by layer, keeping submission order within a layer so
+  // overlapping sprites always stack the same way, and draws each run of
+  // consecutive sprites sharing a texture with a single SDL_RenderGeometry
+  // call. Submitting same-texture sprites together (or atlasing them)
+  // gives longer runs.
+  //
+  // SubmitEntity culls sprites whose screen rect (after camera and scaling)
+  // misses the render output before doing any texture or frame work.
+  //
+  // SubmitEntities/SubmitSprites do the same for a whole list, computing
+  // every screen rect in one vectorized pass (see TransformRects) first.
+  // Given the list's EntityColumns rows (EntityManager::GetViewRows),
+  // SubmitEntities reads positions and sizes from the columns and only
+  // touches the Entity objects that survive culling.
+  void BeginBatch();
+  void SubmitEntity(const Entity *entity);
+  void SubmitSprite(const RenderSprite &sprite);
+  void SubmitEntities(const std::vector<Entity *> &entities);
+  void SubmitEntities(const std::vector<Entity *> &entities,
+                      const std::vector<uint32_t> &rows);
+  void SubmitSprites(const std::vector<RenderSprite> &batch);
+  void FlushBatch();
+
+  size_t GetLastDrawCalls() const { return lastDrawCalls; }
+  size_t GetLastSpriteCount() const { return lastSpriteCount; }
+  size_t GetLastCulledCount() const { return lastCulledCount; }
+
+  void SetBackgroundColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);
+  void Clear();
+  void Present();
+
+ private:
+  SDL_FRect CalculateRenderRect(const Entity *entity);
+  SDL_FRect CalculateRenderRect(vec2 pos, vec2 dims);
+  RectTransform viewTransform() const;
+  // Fills rects from positions/dimensions
+  void transformBatch();
+  bool culled(const SDL_FRect &dst) const;
+  // Culls entities against rects and submits the rest
+  void submitEntities(const std::vector<Entity *> &entities);
+  void submit(const Texture &texture, const SDL_FRect *local, const SDL_FRect &dst, int layer);
+  void drawRun(size_t begin, size_t end);
+
+  // Reused across frames to avoid per-frame allocation
+  std::vector<SpriteInstance> sprites;
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+  std::vector<vec2> positions;
+  std::vector<vec2> dimensions;
+  std::vector<SDL_FRect> rects;
+  Camera camera;
+  SDL_FRect viewport = {0, 0, 0, 0};  // screen space, set by BeginBatch
+  size_t culledCount = 0;
+  size_t lastDrawCalls = 0;
+  size_t lastSpriteCount = 0;
+  size_t lastCulledCount = 0;
+};
+
+// The texture to draw for a sheet: the shared asset's current texture (its
+// placeholder while loading) or the raw sheet for unmanaged textures.
+SDL_Texture *SheetFor(const Texture &texture);
+
+// Maps a sheet-local source rect (nullptr = whole sheet) to what SDL should
+// sample from SheetFor(texture): atlas coordinates for packed sheets,
+// nullptr for placeholders. storage backs the returned pointer.
+const SDL_FRect *MapSourceRect(const Texture &texture, const SDL_FRect *local,
+                               SDL_FRect &storage);
+
+SDL_Texture *LoadTexture(SDL_Renderer *renderer, const char *path);
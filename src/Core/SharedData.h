@@ -1,9 +1,25 @@
-#pragma once
-#include <atomic>
-#include <mutex>
-#include <string>
-#include <condition_variable>
-
-struct SharedData {
-    std::atomic<size_t> nextJobIndex{0};
-};
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <condition_variable>
+
+struct JobTask;
+
+struct SharedData {
+    std::atomic<size_t> nextJobIndex{0};
+
+    // Tasks submitted from threads outside the pool, guarded by injectionMutex
+    std::mutex injectionMutex;
+    std::deque<JobTask*> injectionQueue;
+
+    // Worker parking. queuedTasks counts tasks sitting in any deque or the
+    // injection queue; workers only sleep while it is zero.
+    std::atomic<int> queuedTasks{0};
+    std::atomic<int> sleepingWorkers{0};
+    std::mutex poolMutex;
+    std::condition_variable workAvailable;
+    bool shuttingDown = false;
+};
@@ -0,0 +1,196 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "JobSystem.h"
+
+// Coroutine jobs on top of JobSystem.
+//
+// Task<T> is a lazily started coroutine. Awaiting it from another coroutine
+// runs it and resumes the awaiter when it finishes; Spawn() detaches a
+// Task<void> onto a JobSystem. Suspension points never block a worker: the
+// awaiters below park the coroutine and resubmit it to the pool once it can
+// continue.
+//
+//   Task<> Example(JobSystem &js, FrameSignal &frame) {
+//     co_await ScheduleOn(js);                 // hop onto a worker
+//     co_await RunJob(js, [] { heavyWork(); });  // child job
+//     co_await frame;                          // wait for the next frame
+//   }
+template <typename T = void>
+class Task;
+
+namespace detail {
+struct TaskPromiseBase {
+  std::coroutine_handle<> continuation = std::noop_coroutine();
+
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+      return h.promise().continuation;
+    }
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() const noexcept { std::terminate(); }
+};
+}  // namespace detail
+
+template <typename T>
+class Task {
+ public:
+  struct promise_type : detail::TaskPromiseBase {
+    std::optional<T> value;
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    void return_value(T v) { value = std::move(v); }
+  };
+
+  Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+  Task(const Task &) = delete;
+  ~Task() {
+    if (handle) handle.destroy();
+  }
+
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    handle.promise().continuation = awaiting;
+    return handle;
+  }
+  T await_resume() { return std::move(*handle.promise().value); }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+  std::coroutine_handle<promise_type> handle;
+};
+
+template <>
+class Task<void> {
+ public:
+  struct promise_type : detail::TaskPromiseBase {
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    void return_void() const noexcept {}
+  };
+
+  Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+  Task(const Task &) = delete;
+  ~Task() {
+    if (handle) handle.destroy();
+  }
+
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    handle.promise().continuation = awaiting;
+    return handle;
+  }
+  void await_resume() const noexcept {}
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+  std::coroutine_handle<promise_type> handle;
+};
+
+// Resumes the awaiting coroutine on a JobSystem worker.
+struct ScheduleAwaiter {
+  JobSystem &jobSystem;
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> h) {
+    jobSystem.Submit([h]() { h.resume(); });
+  }
+  void await_resume() const noexcept {}
+};
+
+inline ScheduleAwaiter ScheduleOn(JobSystem &jobSystem) { return {jobSystem}; }
+
+// Runs job on the pool and resumes the awaiting coroutine on the same worker
+// once it has finished.
+struct JobAwaiter {
+  JobSystem &jobSystem;
+  Job job;
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> h) {
+    jobSystem.Submit([this, h]() {
+      job();
+      h.resume();
+    });
+  }
+  void await_resume() const noexcept {}
+};
+
+inline JobAwaiter RunJob(JobSystem &jobSystem, Job job) {
+  return {jobSystem, std::move(job)};
+}
+
+// Coroutines awaiting a FrameSignal are parked until the owner calls Signal()
+// (once per frame) and then resumed on the JobSystem.
+class FrameSignal {
+ public:
+  explicit FrameSignal(JobSystem &jobSystem) : jobSystem(jobSystem) {}
+
+  struct Awaiter {
+    FrameSignal &signal;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) {
+      std::lock_guard<std::mutex> lock(signal.mutex);
+      signal.waiters.push_back(h);
+    }
+    void await_resume() const noexcept {}
+  };
+
+  Awaiter operator co_await() { return {*this}; }
+
+  void Signal() {
+    std::vector<std::coroutine_handle<>> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ready.swap(waiters);
+    }
+    for (auto h : ready) {
+      jobSystem.Submit([h]() { h.resume(); });
+    }
+  }
+
+ private:
+  JobSystem &jobSystem;
+  std::mutex mutex;
+  std::vector<std::coroutine_handle<>> waiters;
+};
+
+namespace detail {
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() const noexcept { return {}; }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+};
+
+inline DetachedTask RunDetached(JobSystem &jobSystem, Task<> task, JobCounter *done) {
+  co_await ScheduleOn(jobSystem);
+  co_await task;
+  if (done && done->pending.fetch_sub(1) == 1) {
+    jobSystem.WakeWaiters();
+  }
+}
+}  // namespace detail
+
+// Starts task on the pool without waiting for it. If done is given it counts
+// the task as pending until it completes, so callers can WaitForCounter.
+inline void Spawn(JobSystem &jobSystem, Task<> task, JobCounter *done = nullptr) {
+  if (done) {
+    done->pending.fetch_add(1, std::memory_order_relaxed);
+  }
+  detail::RunDetached(jobSystem, std::move(task), done);
+}
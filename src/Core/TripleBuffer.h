@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer triple buffer.
+//
+// The producer fills WriteBuffer() and calls Publish(); the consumer calls
+// Acquire() and reads ReadBuffer(). Neither side ever waits for the other:
+// the producer always has a free buffer to write, and the consumer always
+// sees the most recently published one (intermediate ones are dropped).
+// Buffers are reused, so T's storage (e.g. vector capacity) carries over.
+template <typename T>
+class TripleBuffer {
+ public:
+  T &WriteBuffer() { return buffers[writeIndex]; }
+
+  void Publish() {
+    uint8_t previous = middle.exchange(writeIndex | kFresh, std::memory_order_acq_rel);
+    writeIndex = previous & kIndexMask;
+  }
+
+  // Returns true if a newer buffer was published since the last call.
+  bool Acquire() {
+    if (!(middle.load(std::memory_order_relaxed) & kFresh)) {
+      return false;
+    }
+    uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+    readIndex = previous & kIndexMask;
+    return true;
+  }
+
+  const T &ReadBuffer() const { return buffers[readIndex]; }
+
+ private:
+  static constexpr uint8_t kIndexMask = 0x3;
+  static constexpr uint8_t kFresh = 0x4;
+
+  T buffers[3];
+  std::atomic<uint8_t> middle{1};
+  uint8_t writeIndex = 0;  // producer only
+  uint8_t readIndex = 2;   // consumer only
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models").
+//
+// The owning worker pushes and pops at the bottom; any other thread may steal
+// from the top. T must be trivially copyable (the JobSystem stores pointers).
+// The ring buffer grows on demand; retired buffers are kept alive until the
+// deque is destroyed because a thief may still be reading from them.
+template <typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(int64_t initialCapacity = 256) {
+        int64_t capacity = 1;
+        while (capacity < initialCapacity) capacity <<= 1;
+        buffers.push_back(std::make_unique<Buffer>(capacity));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only.
+    void Push(T item) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) {
+            a = Grow(a, t, b);
+        }
+        a->Put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only. Returns false when the deque is empty or a thief won the
+    // race for the last item.
+    bool Pop(T& out) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = a->Get(b);
+        if (t == b) {
+            // Last item: race against thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread.
+    bool Steal(T& out) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+
+        Buffer* a = buffer.load(std::memory_order_acquire);
+        T item = a->Get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return false;
+        }
+        out = item;
+        return true;
+    }
+
+    bool Empty() const {
+        return bottom.load(std::memory_order_relaxed) <=
+               top.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer {
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+
+        explicit Buffer(int64_t cap)
+            : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+
+        T Get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void Put(int64_t i, T item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+    };
+
+    Buffer* Grow(Buffer* old, int64_t t, int64_t b) {
+        auto grown = std::make_unique<Buffer>(old->capacity * 2);
+        for (int64_t i = t; i < b; ++i) {
+            grown->Put(i, old->Get(i));
+        }
+        Buffer* raw = grown.get();
+        buffers.push_back(std::move(grown));
+        buffer.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Buffer*> buffer{nullptr};
+    std::vector<std::unique_ptr<Buffer>> buffers;  // owner only
+};
@@ -0,0 +1,62 @@
+#include "ComponentRegistry.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+struct Registry {
+  std::shared_mutex mutex;
+  std::unordered_map<std::string, ComponentId> ids;
+  std::vector<std::string> names;
+
+  Registry() {
+    // Must match the kXxxComponentId constants
+    add("collision");
+    add("camera");
+  }
+
+  ComponentId add(const std::string &name) {
+    ComponentId id = (ComponentId)names.size();
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+  }
+};
+
+Registry &registry() {
+  static Registry instance;
+  return instance;
+}
+}  // namespace
+
+ComponentId ComponentRegistry::Intern(std::string_view name) {
+  Registry &r = registry();
+  std::string key(name);
+  {
+    std::shared_lock<std::shared_mutex> lock(r.mutex);
+    auto it = r.ids.find(key);
+    if (it != r.ids.end()) {
+      return it->second;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(r.mutex);
+  auto it = r.ids.find(key);
+  if (it != r.ids.end()) {
+    return it->second;
+  }
+  return r.add(key);
+}
+
+std::string ComponentRegistry::NameOf(ComponentId id) {
+  Registry &r = registry();
+  std::shared_lock<std::shared_mutex> lock(r.mutex);
+  return id < r.names.size() ? r.names[id] : std::string();
+}
+
+size_t ComponentRegistry::Count() {
+  Registry &r = registry();
+  std::shared_lock<std::shared_mutex> lock(r.mutex);
+  return r.names.size();
+}
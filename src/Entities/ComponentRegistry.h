@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using ComponentId = uint16_t;
+
+// Built-in components have fixed ids so engine systems can use them as
+// compile-time constants. Physics state is not a component: it lives in
+// EntityColumns (see Entity::EnablePhysics).
+constexpr ComponentId kCollisionComponentId = 0;
+constexpr ComponentId kCameraComponentId = 1;
+
+// Interns component names ("grounded", "health", ...) into dense integer
+// ids. Interning takes a lock and hashes the name, so hot code should resolve
+// a name once through a ComponentKey and reuse it.
+class ComponentRegistry {
+ public:
+  static ComponentId Intern(std::string_view name);
+  static std::string NameOf(ComponentId id);
+  static size_t Count();
+};
+
+// A resolved component name. Define these once (as statics or inline
+// globals) and pass them to Entity::getComponent/setComponent/hasComponent.
+struct ComponentKey {
+  ComponentId id;
+
+  constexpr explicit ComponentKey(ComponentId id) : id(id) {}
+  explicit ComponentKey(std::string_view name)
+      : id(ComponentRegistry::Intern(name)) {}
+};
+
+namespace Components {
+constexpr ComponentKey Collision{kCollisionComponentId};
+// vec2 camera position (world coordinates of the view's top-left) on
+// entities that own a view, i.e. players. Sent to clients as CAM lines.
+constexpr ComponentKey Camera{kCameraComponentId};
+}  // namespace Components
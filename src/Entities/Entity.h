@@ -1,274 +1,429 @@
-#pragma once
-#include "Timeline/Timeline.h"
-#include <SDL3/SDL.h>
-#include <map>
-#include <string>
-
-#include <vector>
-#include <variant>
-#include <mutex>
-
-#include "Input/Input.h"
-#include "Math/vec2.h"
-
-class EntityManager;
-class Entity;
-
-typedef struct CollisionData {
-  vec2 point;
-  vec2 normal;
-} CollisionData;
-
-typedef struct Texture {
-  SDL_Texture *sheet;
-  uint32_t num_frames_x;
-  uint32_t num_frames_y;
-  uint32_t frame_width;
-  uint32_t frame_height;
-  bool loop;
-} Texture;
-
-typedef struct Physics {
-  bool affectedByGravity = false;
-  vec2 velocity;
-  vec2 force;
-} PhysicsComponent;
-
-typedef struct RenderComponent {
-  bool isVisible = true;
-  std::map<int, Texture> textures;
-  int currentTextureState = 0;
-  int currentFrame = 0;
-  float offSetX = 0.0f;
-  float offSetY = 0.0f;
-} RenderComponent;
-
-typedef struct CollisionComponent {
-  bool ghostEntity;
-  bool isKinematic = false;
-} CollisionComponent;
-
-using Component = std::variant<int, 
-float, 
-bool, 
-std::string, 
-vec2, 
-PhysicsComponent, 
-Uint32,
-Entity*,
-CollisionComponent>;
-
-class Entity {
- private:
-  inline static int nextId =
-      0;  // <-- inline variable: defined once program-wide
-  int id;
-
- protected:
-  std::map<std::string, Component> components;
-  mutable std::mutex componentMutex;  // Protects access to components map
-
- public:
-  std::string entityType;
-
-  vec2 position;
-  vec2 dimensions;  
-
-  bool physicsEnabled = false;
-
-  bool collisionEnabled = false;
-  
-  Timeline *timeline = nullptr;
-
-  RenderComponent rendering;
-  
-  // bool isStatic = false;  // Renamed to isKinematic in CollisionComponent struct
-
-  virtual bool GetSourceRect(SDL_FRect &out) const {
-    (void)out;
-    return false;
-  }
-
-  void SetDimensions(float w, float h) {
-    this->dimensions.x = w;
-    this->dimensions.y = h;
-  }
-
-  void SetCurrentFrame(int frame) {
-    rendering.currentFrame = frame;
-  }
-
-  void SetVisible(bool visible) {
-    rendering.isVisible = visible;
-  }
-
-  void SetOffSetX(float offSetX) {
-    rendering.offSetX = offSetX;
-  }
-
-  void SetOffSetY(float offSetY) {
-    rendering.offSetY = offSetY;
-  }
-
-  float GetOffSetX() const {
-    return rendering.offSetX;
-  }
-
-  float GetOffSetY() const {
-    return rendering.offSetY;
-  }
-
-  Entity(float startX = 0.0f, float startY = 0.0f, float w = 32.0f,
-         float h = 32.0f, Timeline *tl = nullptr)
-      : id(nextId++), position({.x = startX, .y = startY}), dimensions({.x = w, .y = h}) {
-    timeline = tl;
-  }
-  virtual ~Entity() = default;
-
-  int GetId() const { return id; }
-  void SetId(int id) { this->id = id; }
-
-  void EnableCollision(bool ghostEntity = false, bool isKinematic = true) {
-    collisionEnabled = true;
-    setComponent("collision", CollisionComponent{
-      .ghostEntity = ghostEntity,
-      .isKinematic = isKinematic
-    });
-  }
-
-  void SetGhostEntity(bool ghostEntity) {
-    if(collisionEnabled) {
-      getComponent<CollisionComponent>("collision").ghostEntity = ghostEntity;
-    }
-  }
-
-  void SetIsKinematic(bool isKinematic) {
-    if(collisionEnabled) {
-      getComponent<CollisionComponent>("collision").isKinematic = isKinematic;
-    }
-  }
-
-  void EnablePhysics(bool affectedByGravity = true) {
-    physicsEnabled = true;
-    setComponent("physics", PhysicsComponent{
-      .affectedByGravity = affectedByGravity,
-      .velocity = {0.0f, 0.0f},
-      .force = {0.0f, affectedByGravity ? 9.8f * 300.0f : 0.0f}
-    });
-  }
-
-  void SetAffectedByGravity(bool affectedByGravity) {
-    if(physicsEnabled) {
-      getComponent<PhysicsComponent>("physics").affectedByGravity = affectedByGravity;
-      getComponent<PhysicsComponent>("physics").force.y = affectedByGravity ? 9.8f * 300.0f : 0.0f;
-    }
-  }
-  
-  void SetVelocity(float x, float y) {
-    if(physicsEnabled) {
-      getComponent<PhysicsComponent>("physics").velocity = {x, y};
-    }
-  }
-
-  void SetVelocityX(float x) {
-    if(physicsEnabled) {
-      getComponent<PhysicsComponent>("physics").velocity.x = x;
-    }
-  }
-
-  void SetVelocityY(float y) {
-    if(physicsEnabled) {
-      getComponent<PhysicsComponent>("physics").velocity.y = y;
-    }
-  }
-
-  float GetVelocityX() {
-    if(physicsEnabled) {
-      return getComponent<PhysicsComponent>("physics").velocity.x;
-    }
-    return 0.0f;
-  }
-
-  float GetVelocityY() {
-    if(physicsEnabled) {
-      return getComponent<PhysicsComponent>("physics").velocity.y;
-    }
-    return 0.0f;
-  }
-
-  void SetForce(float x, float y) {
-    if(physicsEnabled) {
-      getComponent<PhysicsComponent>("physics").force = {x, y};
-    }
-  }
-
-  virtual void Update(float, InputManager *, EntityManager *) {}
-  virtual void OnActivity(const std::string&) {}
-  virtual void OnCollision(Entity *, CollisionData *) {}
-
-
-  bool hasComponent(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(componentMutex);
-    return components.find(key) != components.end();
-  }
-  
-  void setComponent(const std::string& key, Component value) {
-    std::lock_guard<std::mutex> lock(componentMutex);
-    components[key] = value;
-  } 
- 
-
-  template <typename T>
-  T& getComponent(const std::string& key) {
-      std::lock_guard<std::mutex> lock(componentMutex);
-      return std::get<T>(components.at(key));
-  }
-
-  void SetTexture(int state, Texture *tex) {
-    rendering.textures[state] = *tex;
-    if(rendering.textures.size() == 1) {
-      rendering.currentTextureState = state;
-    }
-  }
-
-  void SetTextureState(int state) {
-    if(rendering.textures.find(state) != rendering.textures.end()) {
-      rendering.currentTextureState = state;
-    }
-
-  }
-
-  inline SDL_FRect GetBounds() const {
-    return SDL_FRect{position.x, position.y, dimensions.x, dimensions.y};
-  }
-
-  inline void SetPosition(float newX, float newY) {
-    position = {.x = newX, .y = newY};
-  }
-  
-  SDL_FRect SampleTextureAt(int x, int y) const {
-    auto it = rendering.textures.find(rendering.currentTextureState);
-    if (it == rendering.textures.end()) {
-      return {.x = 0, .y = 0, .w = 0, .h = 0}; // Return empty rect if texture not found
-    }
-    const Texture& tex = it->second;
-    return {
-      .x = (float)(x * tex.frame_width),
-      .y = (float)(y * tex.frame_height),
-      .w = (float)(tex.frame_width),
-      .h = (float)(tex.frame_height)
-    };  
-  }
-};
-
-class EntityManager {
-  std::vector<Entity *> entities;
-
- public:
-  EntityManager() {}
-  void AddEntity(Entity *entity);
-  void RemoveEntity(Entity *entity);
-  void ClearAllEntities();
-  std::vector<Entity *> &getEntityVectorRef() { return entities; };
-};
-
+#pragma once
+#include "Core/AssetManager.h"
+#include "Timeline/Timeline.h"
+#include <SDL3/SDL.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include <vector>
+#include <variant>
+#include <atomic>
+#include <mutex>
+
+#include "ComponentRegistry.h"
+#include "EntityColumns.h"
+#include "EntityHandle.h"
+#include "EntityPool.h"
+#include "FlatMap.h"
+#include "Input/Input.h"
+#include "Math/vec2.h"
+
+class EntityManager;
+class Entity;
+class EntityCommandBuffer;
+
+typedef struct CollisionData {
+  vec2 point;
+  vec2 normal;
+} CollisionData;
+
+typedef struct Texture {
+  SDL_Texture *sheet;  // unmanaged sheets only; asset-backed ones draw through asset
+  uint32_t num_frames_x;
+  uint32_t num_frames_y;
+  uint32_t frame_width;
+  uint32_t frame_height;
+  bool loop;
+  TextureHandle asset;  // keeps the shared sheet alive while in use
+} Texture;
+
+typedef struct RenderComponent {
+  bool isVisible = true;
+  FlatMap<int, Texture, 4> textures;
+  int currentTextureState = 0;
+  int currentFrame = 0;
+  int layer = 0;  // batched rendering draws lower layers first
+} RenderComponent;
+
+// Two entities are tested against each other only if each one's category
+// has a bit in the other's mask (see CollisionSystem::ShouldCollide).
+typedef struct CollisionComponent {
+  bool ghostEntity;
+  bool isKinematic = false;
+  uint32_t category = 1;        // layer bits this entity is in
+  uint32_t mask = 0xFFFFFFFFu;  // layer bits it collides with
+} CollisionComponent;
+
+// Cached entity lists kept by EntityManager so systems only visit entities
+// they act on. Membership follows the flags below and is refreshed by the
+// Entity setters (EnablePhysics, SetIsKinematic, SetVisible, ...), so write
+// those flags through the setters rather than directly. Every view keeps
+// insertion order, which is also update, collision and draw order.
+enum class EntityView : uint8_t {
+  Simulated,   // physics enabled and not a kinematic collider
+  Collidable,  // collision enabled
+  Visible,     // rendering.isVisible
+  Count
+};
+constexpr size_t kEntityViewCount = (size_t)EntityView::Count;
+
+using Component = std::variant<int, 
+float, 
+bool, 
+std::string, 
+vec2, 
+Uint32,
+EntityHandle,
+CollisionComponent>;
+
+class Entity {
+ private:
+  // Entities may be constructed on worker threads (e.g. player spawns)
+  inline static std::atomic<int> nextId =
+      0;  // <-- inline variable: defined once program-wide
+  int id;
+  uint32_t columnRow;  // this entity's row in EntityColumns
+
+  // Set by the EntityManager that owns this entity
+  friend class EntityManager;
+  EntityManager *owner = nullptr;
+  EntityHandle handle;
+  uint32_t viewMask = 0;  // bit per EntityView this entity is listed in
+  uint32_t viewIndex[kEntityViewCount] = {};
+
+  // Tells the owning manager to re-evaluate view membership
+  void refreshViews();
+
+ protected:
+  // Keyed by ComponentId, inline for the first few components. Unlocked:
+  // only the thread that owns the entity may change it while systems run,
+  // and adding a component that did not exist yet (which can move existing
+  // entries) must wait for the tick boundary, so from other threads it goes
+  // through EntityManager's command buffer.
+  FlatMap<ComponentId, Component, 8> components;
+
+ public:
+  std::string entityType;
+
+  // Bound to this entity's row in EntityColumns, where physics and the
+  // render pass read them without touching the Entity
+  vec2 &position;
+  vec2 &dimensions;  
+
+  bool physicsEnabled = false;
+
+  bool collisionEnabled = false;
+  
+  Timeline *&timeline;
+
+  RenderComponent rendering;
+  
+  // bool isStatic = false;  // Renamed to isKinematic in CollisionComponent struct
+
+  virtual bool GetSourceRect(SDL_FRect &out) const {
+    (void)out;
+    return false;
+  }
+
+  void SetDimensions(float w, float h) {
+    this->dimensions.x = w;
+    this->dimensions.y = h;
+  }
+
+  void SetCurrentFrame(int frame) {
+    rendering.currentFrame = frame;
+  }
+
+  void SetVisible(bool visible) {
+    if (rendering.isVisible == visible) return;
+    rendering.isVisible = visible;
+    refreshViews();
+  }
+
+  Entity(float startX = 0.0f, float startY = 0.0f, float w = 32.0f,
+         float h = 32.0f, Timeline *tl = nullptr)
+      : id(nextId++),
+        columnRow(EntityColumns::Allocate()),
+        position(EntityColumns::Position(columnRow)),
+        dimensions(EntityColumns::Dimensions(columnRow)),
+        timeline(EntityColumns::TimelineOf(columnRow)) {
+    position = {.x = startX, .y = startY};
+    dimensions = {.x = w, .y = h};
+    timeline = tl;
+  }
+  // A copy would share the original's row
+  Entity(const Entity &) = delete;
+  Entity &operator=(const Entity &) = delete;
+  virtual ~Entity() { EntityColumns::Free(columnRow); }
+
+  // Entities of every subclass come from EntityPool size classes; the sized
+  // delete receives the dynamic type's size through the virtual destructor.
+  static void *operator new(size_t size) { return EntityPool::Allocate(size); }
+  static void operator delete(void *ptr, size_t size) {
+    EntityPool::Free(ptr, size);
+  }
+
+  int GetId() const { return id; }
+  void SetId(int id) { this->id = id; }
+
+  EntityHandle GetHandle() const { return handle; }
+  EntityManager *GetOwner() const { return owner; }
+  uint32_t GetColumnRow() const { return columnRow; }
+
+  // Resolves a handle against this entity's manager; nullptr if the target
+  // has been removed or this entity is not managed.
+  Entity *Resolve(EntityHandle target) const;
+
+  // Which EntityViews this entity currently belongs in
+  uint32_t ComputeViewMask() const {
+    uint32_t mask = 0;
+    bool kinematic = collisionEnabled &&
+        getComponent<CollisionComponent>(Components::Collision).isKinematic;
+    if (physicsEnabled && !kinematic) mask |= 1u << (int)EntityView::Simulated;
+    if (collisionEnabled) mask |= 1u << (int)EntityView::Collidable;
+    if (rendering.isVisible) mask |= 1u << (int)EntityView::Visible;
+    return mask;
+  }
+
+  void EnableCollision(bool ghostEntity = false, bool isKinematic = true) {
+    collisionEnabled = true;
+    setComponent(Components::Collision, CollisionComponent{
+      .ghostEntity = ghostEntity,
+      .isKinematic = isKinematic
+    });
+    refreshViews();
+  }
+
+  void DisableCollision() {
+    collisionEnabled = false;
+    refreshViews();
+  }
+
+  void SetGhostEntity(bool ghostEntity) {
+    if(collisionEnabled) {
+      getComponent<CollisionComponent>(Components::Collision).ghostEntity = ghostEntity;
+    }
+  }
+
+  void SetIsKinematic(bool isKinematic) {
+    if(collisionEnabled) {
+      getComponent<CollisionComponent>(Components::Collision).isKinematic = isKinematic;
+      refreshViews();
+    }
+  }
+
+  void SetCollisionFilter(uint32_t category, uint32_t mask) {
+    if(collisionEnabled) {
+      CollisionComponent &collision = getComponent<CollisionComponent>(Components::Collision);
+      collision.category = category;
+      collision.mask = mask;
+    }
+  }
+
+  // Velocity and force are EntityColumns rows too; they only mean anything
+  // while physics is enabled
+  void EnablePhysics(bool affectedByGravity = true) {
+    physicsEnabled = true;
+    EntityColumns::Velocity(columnRow) = {0.0f, 0.0f};
+    EntityColumns::Force(columnRow) = {0.0f, affectedByGravity ? 9.8f * 300.0f : 0.0f};
+    refreshViews();
+  }
+
+  void DisablePhysics() {
+    physicsEnabled = false;
+    refreshViews();
+  }
+
+  void SetAffectedByGravity(bool affectedByGravity) {
+    if(physicsEnabled) {
+      EntityColumns::Force(columnRow).y = affectedByGravity ? 9.8f * 300.0f : 0.0f;
+    }
+  }
+  
+  void SetVelocity(float x, float y) {
+    if(physicsEnabled) {
+      EntityColumns::Velocity(columnRow) = {x, y};
+    }
+  }
+
+  void SetVelocityX(float x) {
+    if(physicsEnabled) {
+      EntityColumns::Velocity(columnRow).x = x;
+    }
+  }
+
+  void SetVelocityY(float y) {
+    if(physicsEnabled) {
+      EntityColumns::Velocity(columnRow).y = y;
+    }
+  }
+
+  float GetVelocityX() const {
+    if(physicsEnabled) {
+      return EntityColumns::Velocity(columnRow).x;
+    }
+    return 0.0f;
+  }
+
+  float GetVelocityY() const {
+    if(physicsEnabled) {
+      return EntityColumns::Velocity(columnRow).y;
+    }
+    return 0.0f;
+  }
+
+  void SetForce(float x, float y) {
+    if(physicsEnabled) {
+      EntityColumns::Force(columnRow) = {x, y};
+    }
+  }
+
+  virtual void Update(float, InputManager *, EntityManager *) {}
+  virtual void OnActivity(const std::string&) {}
+  virtual void OnCollision(Entity *, CollisionData *) {}
+
+
+  bool hasComponent(ComponentKey key) const {
+    return components.contains(key.id);
+  }
+
+  void setComponent(ComponentKey key, Component value) {
+    components[key.id] = std::move(value);
+  }
+
+  template <typename T>
+  T& getComponent(ComponentKey key) {
+      auto it = components.find(key.id);
+      if (it == components.end()) {
+        throw std::out_of_range("missing component: " + ComponentRegistry::NameOf(key.id));
+      }
+      return std::get<T>(it->second);
+  }
+
+  template <typename T>
+  const T& getComponent(ComponentKey key) const {
+      auto it = components.find(key.id);
+      if (it == components.end()) {
+        throw std::out_of_range("missing component: " + ComponentRegistry::NameOf(key.id));
+      }
+      return std::get<T>(it->second);
+  }
+
+  void SetTexture(int state, Texture *tex) {
+    rendering.textures[state] = *tex;
+    if(rendering.textures.size() == 1) {
+      rendering.currentTextureState = state;
+    }
+  }
+
+  void SetTextureState(int state) {
+    if(rendering.textures.find(state) != rendering.textures.end()) {
+      rendering.currentTextureState = state;
+    }
+
+  }
+
+  inline SDL_FRect GetBounds() const {
+    return SDL_FRect{position.x, position.y, dimensions.x, dimensions.y};
+  }
+
+  inline void SetPosition(float newX, float newY) {
+    position = {.x = newX, .y = newY};
+  }
+  
+  SDL_FRect SampleTextureAt(int x, int y) const {
+    auto it = rendering.textures.find(rendering.currentTextureState);
+    if (it == rendering.textures.end()) {
+      return {.x = 0, .y = 0, .w = 0, .h = 0}; // Return empty rect if texture not found
+    }
+    const Texture& tex = it->second;
+    return {
+      .x = (float)(x * tex.frame_width),
+      .y = (float)(y * tex.frame_height),
+      .w = (float)(tex.frame_width),
+      .h = (float)(tex.frame_height)
+    };  
+  }
+};
+
+class EntityManager {
+  struct Slot {
+    Entity *entity = nullptr;
+    uint32_t generation = 0;
+  };
+
+  std::vector<Entity *> entities;
+  std::unique_ptr<EntityCommandBuffer> commands;
+
+  // Slot map behind EntityHandle, plus network/game id -> handle
+  std::vector<Slot> slots;
+  std::vector<uint32_t> freeSlots;
+  std::unordered_map<int, EntityHandle> idToHandle;
+
+  std::vector<Entity *> views[kEntityViewCount];
+  std::vector<uint32_t> viewRows[kEntityViewCount];  // EntityColumns rows, parallel to views
+  void addToView(EntityView view, Entity *entity);
+  void removeFromView(EntityView view, Entity *entity);
+
+  // Removal is split so a batch pays for one pass: detach invalidates the
+  // entity's handle and id at once but leaves it in entities and the views,
+  // and compact then drops every detached entry, keeping the order of the
+  // rest. Detached entities must stay alive until compact has run.
+  friend class EntityCommandBuffer;
+  size_t detachedCount = 0;
+  void detach(Entity *entity);
+  void compact();
+
+ public:
+  EntityManager();
+  ~EntityManager();
+  // Direct structural changes. Only call these from the thread that owns
+  // the manager and never while a system iterates getEntityVectorRef();
+  // other threads go through GetCommandBuffer(). RemoveEntity keeps the
+  // remaining entities (and every view) in order, so updates and collisions
+  // run in the same order on every replica; it is linear in the entity
+  // count, so remove many at once through the command buffer, which
+  // compacts once per flush.
+  EntityHandle AddEntity(Entity *entity);
+  void RemoveEntity(Entity *entity);
+  void ClearAllEntities();
+
+  // Entities matching a view, maintained incrementally as entities are added,
+  // removed or change the flags the view depends on
+  const std::vector<Entity *> &GetView(EntityView view) const {
+    return views[(size_t)view];
+  }
+  // The same view as EntityColumns rows: element i is the row of
+  // GetView(view)[i], for passes that only need column data
+  const std::vector<uint32_t> &GetViewRows(EntityView view) const {
+    return viewRows[(size_t)view];
+  }
+  void UpdateViews(Entity *entity);
+
+  // Deferred structural changes, applied by FlushCommands()
+  EntityCommandBuffer &GetCommandBuffer() { return *commands; }
+  void FlushCommands();
+
+  std::vector<Entity *> &getEntityVectorRef() { return entities; };
+
+  // O(1) validated lookups; nullptr for stale handles and unknown ids
+  Entity *Get(EntityHandle handle) const {
+    if (handle.index >= slots.size()) return nullptr;
+    const Slot &slot = slots[handle.index];
+    return slot.generation == handle.generation ? slot.entity : nullptr;
+  }
+  Entity *FindById(int id) const {
+    auto it = idToHandle.find(id);
+    return it != idToHandle.end() ? Get(it->second) : nullptr;
+  }
+};
+
+inline Entity *Entity::Resolve(EntityHandle target) const {
+  return owner ? owner->Get(target) : nullptr;
+}
+
+inline void Entity::refreshViews() {
+  if (owner) owner->UpdateViews(this);
+}
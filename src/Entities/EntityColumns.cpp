@@ -0,0 +1,60 @@
+#include "EntityColumns.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+struct RowAllocator {
+  std::mutex mutex;
+  std::vector<uint32_t> freeRows;
+  uint32_t nextRow = 0;  // first row never handed out
+  size_t live = 0;
+};
+
+// Never destroyed: entities may still be deleted during static teardown.
+RowAllocator &allocator() {
+  static RowAllocator *instance = new RowAllocator();
+  return *instance;
+}
+}  // namespace
+
+uint32_t EntityColumns::Allocate() {
+  RowAllocator &a = allocator();
+  uint32_t row;
+  {
+    std::lock_guard<std::mutex> lock(a.mutex);
+    if (!a.freeRows.empty()) {
+      row = a.freeRows.back();
+      a.freeRows.pop_back();
+    } else {
+      if (a.nextRow == kRowsPerChunk * kMaxChunks) {
+        throw std::length_error("EntityColumns: too many live entities");
+      }
+      row = a.nextRow++;
+      if (slot(row) == 0) {
+        chunks[row / kRowsPerChunk] = new Chunk();
+      }
+    }
+    a.live++;
+  }
+  Position(row) = {0.0f, 0.0f};
+  Dimensions(row) = {0.0f, 0.0f};
+  Velocity(row) = {0.0f, 0.0f};
+  Force(row) = {0.0f, 0.0f};
+  TimelineOf(row) = nullptr;
+  return row;
+}
+
+void EntityColumns::Free(uint32_t row) {
+  RowAllocator &a = allocator();
+  std::lock_guard<std::mutex> lock(a.mutex);
+  a.freeRows.push_back(row);
+  a.live--;
+}
+
+size_t EntityColumns::LiveRows() {
+  RowAllocator &a = allocator();
+  std::lock_guard<std::mutex> lock(a.mutex);
+  return a.live;
+}
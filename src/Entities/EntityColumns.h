@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Math/vec2.h"
+
+class Timeline;
+
+// Column (structure-of-arrays) storage for the per-entity data that physics
+// and rendering sweep every frame: position, dimensions, velocity, force and
+// the timeline that scales them.
+//
+// Every Entity owns one row for its whole lifetime; Entity::position,
+// dimensions and timeline are references into it, so existing subclasses
+// read and write the columns without change. Rows live in chunks of
+// kRowsPerChunk and each chunk keeps one array per column, so a pass that
+// walks a list of rows touches only the columns it uses rather than whole
+// Entity objects. Chunks are never moved or freed, which keeps those
+// references valid; freed rows are reused by the next entity.
+//
+// Like EntityPool this is process-wide: an entity needs its row before any
+// EntityManager sees it. Allocate/Free take a lock; the accessors do not.
+class EntityColumns {
+ public:
+  static constexpr uint32_t kRowsPerChunk = 1024;
+  static constexpr uint32_t kMaxChunks = 4096;
+
+  // A zeroed row (null timeline); throws std::length_error once
+  // kRowsPerChunk * kMaxChunks rows are live.
+  static uint32_t Allocate();
+  static void Free(uint32_t row);
+  static size_t LiveRows();
+
+  static vec2 &Position(uint32_t row) { return chunk(row).position[slot(row)]; }
+  static vec2 &Dimensions(uint32_t row) { return chunk(row).dimensions[slot(row)]; }
+  static vec2 &Velocity(uint32_t row) { return chunk(row).velocity[slot(row)]; }
+  static vec2 &Force(uint32_t row) { return chunk(row).force[slot(row)]; }
+  static Timeline *&TimelineOf(uint32_t row) { return chunk(row).timeline[slot(row)]; }
+
+ private:
+  struct Chunk {
+    vec2 position[kRowsPerChunk];
+    vec2 dimensions[kRowsPerChunk];
+    vec2 velocity[kRowsPerChunk];
+    vec2 force[kRowsPerChunk];
+    Timeline *timeline[kRowsPerChunk];
+  };
+
+  // Each entry is written once, under the allocation lock, before any row
+  // in that chunk is handed out
+  inline static Chunk *chunks[kMaxChunks] = {};
+
+  static Chunk &chunk(uint32_t row) { return *chunks[row / kRowsPerChunk]; }
+  static uint32_t slot(uint32_t row) { return row % kRowsPerChunk; }
+};
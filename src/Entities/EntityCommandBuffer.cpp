@@ -0,0 +1,78 @@
+#include "EntityCommandBuffer.h"
+
+void EntityCommandBuffer::Spawn(Entity *entity, SpawnCallback onSpawned) {
+  Command command;
+  command.type = CommandType::Spawn;
+  command.entity = entity;
+  command.onSpawned = std::move(onSpawned);
+  std::lock_guard<std::mutex> lock(mutex);
+  commands.push_back(std::move(command));
+}
+
+void EntityCommandBuffer::Despawn(EntityHandle handle) {
+  Command command;
+  command.type = CommandType::Despawn;
+  command.handle = handle;
+  std::lock_guard<std::mutex> lock(mutex);
+  commands.push_back(std::move(command));
+}
+
+void EntityCommandBuffer::AddComponent(EntityHandle handle, ComponentKey key,
+                                       Component value) {
+  Command command;
+  command.type = CommandType::AddComponent;
+  command.handle = handle;
+  command.componentId = key.id;
+  command.value = std::move(value);
+  std::lock_guard<std::mutex> lock(mutex);
+  commands.push_back(std::move(command));
+}
+
+void EntityCommandBuffer::Flush(EntityManager &manager) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (commands.empty()) {
+      return;
+    }
+    applying.swap(commands);
+  }
+
+  // Commands recorded by spawn callbacks land in the next flush. Despawned
+  // entities are detached at once, so later commands see their handles as
+  // stale, and removed from the arrays in one order-preserving pass at the
+  // end; they are deleted only after that pass.
+  for (Command &command : applying) {
+    switch (command.type) {
+      case CommandType::Spawn: {
+        EntityHandle handle = manager.AddEntity(command.entity);
+        if (command.onSpawned) {
+          command.onSpawned(command.entity, handle);
+        }
+        break;
+      }
+      case CommandType::Despawn:
+        if (Entity *entity = manager.Get(command.handle)) {
+          manager.detach(entity);
+          despawned.push_back(entity);
+        }
+        break;
+      case CommandType::AddComponent:
+        if (Entity *entity = manager.Get(command.handle)) {
+          entity->setComponent(ComponentKey(command.componentId),
+                               std::move(command.value));
+        }
+        break;
+    }
+  }
+  manager.compact();
+  for (Entity *entity : despawned) {
+    delete entity;
+  }
+  despawned.clear();
+  applying.clear();
+}
+
+size_t EntityCommandBuffer::PendingCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return commands.size();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "Entity.h"
+
+// Records structural changes (spawn, despawn, add component) from any
+// thread and applies them in one batch at a tick boundary, so systems that
+// iterate EntityManager's entity array never see it change underneath them.
+//
+// Commands are applied in the order they were recorded. Despawn and
+// AddComponent take handles and are silently dropped if the target is gone
+// by the time the buffer is flushed. All despawns in one flush share a
+// single order-preserving compaction of the entity array.
+class EntityCommandBuffer {
+ public:
+  // Called during Flush once the entity has been added, on the flushing
+  // thread. It may touch the EntityManager directly.
+  using SpawnCallback = std::function<void(Entity *, EntityHandle)>;
+
+  // Takes ownership of entity.
+  void Spawn(Entity *entity, SpawnCallback onSpawned = nullptr);
+  // Removes and deletes the entity.
+  void Despawn(EntityHandle handle);
+  void AddComponent(EntityHandle handle, ComponentKey key, Component value);
+
+  // Applies and clears all recorded commands. Must be called from the
+  // thread that owns the EntityManager, outside any system iteration.
+  void Flush(EntityManager &manager);
+
+  size_t PendingCount() const;
+
+ private:
+  enum class CommandType { Spawn, Despawn, AddComponent };
+
+  struct Command {
+    CommandType type = CommandType::Spawn;
+    Entity *entity = nullptr;
+    EntityHandle handle;
+    ComponentId componentId = 0;
+    Component value;
+    SpawnCallback onSpawned;
+  };
+
+  mutable std::mutex mutex;
+  std::vector<Command> commands;
+  std::vector<Command> applying;  // swapped in by Flush, reused across ticks
+  std::vector<Entity *> despawned;  // detached by Flush, deleted after compaction
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+// Weak reference to an entity owned by an EntityManager: a slot index plus
+// the generation the slot had when the handle was issued. Once the entity is
+// removed the slot's generation moves on and the handle resolves to nullptr
+// instead of a dangling pointer.
+struct EntityHandle {
+  static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+  uint32_t index = kInvalidIndex;
+  uint32_t generation = 0;
+
+  bool IsNull() const { return index == kInvalidIndex; }
+
+  bool operator==(const EntityHandle &other) const {
+    return index == other.index && generation == other.generation;
+  }
+  bool operator!=(const EntityHandle &other) const { return !(*this == other); }
+};
+
+template <>
+struct std::hash<EntityHandle> {
+  size_t operator()(const EntityHandle &h) const noexcept {
+    return std::hash<uint64_t>()(((uint64_t)h.generation << 32) | h.index);
+  }
+};
@@ -1,12 +1,132 @@
-#include <algorithm>
-
-#include "Entity.h"
-
-void EntityManager::AddEntity(Entity *entity) { entities.push_back(entity); }
-
-void EntityManager::RemoveEntity(Entity *entity) {
-  entities.erase(std::remove(entities.begin(), entities.end(), entity),
-                 entities.end());
-}
-
-void EntityManager::ClearAllEntities() { entities.clear(); }
+#include "Entity.h"
+#include "EntityCommandBuffer.h"
+
+EntityManager::EntityManager()
+    : commands(std::make_unique<EntityCommandBuffer>()) {}
+
+EntityManager::~EntityManager() = default;
+
+EntityHandle EntityManager::AddEntity(Entity *entity) {
+  uint32_t index;
+  if (!freeSlots.empty()) {
+    index = freeSlots.back();
+    freeSlots.pop_back();
+  } else {
+    index = (uint32_t)slots.size();
+    slots.push_back({});
+  }
+  slots[index].entity = entity;
+
+  EntityHandle handle{index, slots[index].generation};
+  entity->owner = this;
+  entity->handle = handle;
+  idToHandle[entity->GetId()] = handle;
+
+  entities.push_back(entity);
+  UpdateViews(entity);
+  return handle;
+}
+
+void EntityManager::RemoveEntity(Entity *entity) {
+  detach(entity);
+  compact();
+}
+
+void EntityManager::detach(Entity *entity) {
+  EntityHandle handle = entity->handle;
+  if (entity->owner != this || Get(handle) != entity) {
+    return;
+  }
+  // Bumping the generation invalidates every outstanding handle
+  slots[handle.index].entity = nullptr;
+  slots[handle.index].generation++;
+  freeSlots.push_back(handle.index);
+
+  auto it = idToHandle.find(entity->GetId());
+  if (it != idToHandle.end() && it->second == handle) {
+    idToHandle.erase(it);
+  }
+  entity->owner = nullptr;
+  entity->handle = EntityHandle{};
+  entity->viewMask = 0;
+  detachedCount++;
+}
+
+void EntityManager::compact() {
+  if (detachedCount == 0) {
+    return;
+  }
+  detachedCount = 0;
+  std::erase_if(entities, [this](Entity *entity) { return entity->owner != this; });
+  for (size_t v = 0; v < kEntityViewCount; ++v) {
+    std::vector<Entity *> &list = views[v];
+    std::vector<uint32_t> &rows = viewRows[v];
+    size_t kept = 0;
+    for (size_t i = 0; i < list.size(); ++i) {
+      if (list[i]->owner != this) continue;
+      list[i]->viewIndex[v] = (uint32_t)kept;
+      list[kept] = list[i];
+      rows[kept] = rows[i];
+      kept++;
+    }
+    list.resize(kept);
+    rows.resize(kept);
+  }
+}
+
+void EntityManager::FlushCommands() { commands->Flush(*this); }
+
+void EntityManager::ClearAllEntities() {
+  for (uint32_t i = 0; i < slots.size(); ++i) {
+    if (slots[i].entity) {
+      slots[i].entity->owner = nullptr;
+      slots[i].entity->viewMask = 0;
+      slots[i].entity = nullptr;
+      slots[i].generation++;
+      freeSlots.push_back(i);
+    }
+  }
+  idToHandle.clear();
+  entities.clear();
+  detachedCount = 0;
+  for (size_t v = 0; v < kEntityViewCount; ++v) {
+    views[v].clear();
+    viewRows[v].clear();
+  }
+}
+
+void EntityManager::UpdateViews(Entity *entity) {
+  if (entity->owner != this) return;
+  uint32_t mask = entity->ComputeViewMask();
+  uint32_t changed = mask ^ entity->viewMask;
+  for (size_t v = 0; v < kEntityViewCount; ++v) {
+    if (!(changed & (1u << v))) continue;
+    if (mask & (1u << v)) {
+      addToView((EntityView)v, entity);
+    } else {
+      removeFromView((EntityView)v, entity);
+    }
+  }
+  entity->viewMask = mask;
+}
+
+void EntityManager::addToView(EntityView view, Entity *entity) {
+  std::vector<Entity *> &list = views[(size_t)view];
+  entity->viewIndex[(size_t)view] = (uint32_t)list.size();
+  list.push_back(entity);
+  viewRows[(size_t)view].push_back(entity->columnRow);
+}
+
+void EntityManager::removeFromView(EntityView view, Entity *entity) {
+  std::vector<Entity *> &list = views[(size_t)view];
+  size_t v = (size_t)view;
+  std::vector<uint32_t> &rows = viewRows[v];
+  uint32_t index = entity->viewIndex[v];
+  // Order is update/collision/draw order, so shift the tail down instead of
+  // swapping
+  list.erase(list.begin() + index);
+  rows.erase(rows.begin() + index);
+  for (size_t i = index; i < list.size(); ++i) {
+    list[i]->viewIndex[v] = (uint32_t)i;
+  }
+}
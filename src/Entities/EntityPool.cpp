@@ -0,0 +1,113 @@
+#include "EntityPool.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace {
+constexpr size_t kNumClasses =
+    EntityPool::kMaxPooledSize / EntityPool::kClassGranularity;
+constexpr std::align_val_t kBlockAlign{EntityPool::kClassGranularity};
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+struct SizeClass {
+  std::mutex mutex;
+  FreeBlock *freeList = nullptr;
+  std::vector<void *> chunks;
+  EntityPoolStats stats;
+
+  void grow() {
+    size_t blocksPerChunk =
+        std::max<size_t>(8, EntityPool::kChunkBytes / stats.blockSize);
+    char *chunk = static_cast<char *>(
+        ::operator new(blocksPerChunk * stats.blockSize, kBlockAlign));
+    chunks.push_back(chunk);
+    for (size_t i = blocksPerChunk; i-- > 0;) {
+      FreeBlock *block =
+          reinterpret_cast<FreeBlock *>(chunk + i * stats.blockSize);
+      block->next = freeList;
+      freeList = block;
+    }
+    stats.chunks++;
+    stats.capacity += blocksPerChunk;
+  }
+};
+
+struct Pools {
+  SizeClass classes[kNumClasses];
+
+  Pools() {
+    for (size_t i = 0; i < kNumClasses; ++i) {
+      classes[i].stats.blockSize = (i + 1) * EntityPool::kClassGranularity;
+    }
+  }
+};
+
+// Never destroyed: entities may still be deleted during static teardown.
+Pools &pools() {
+  static Pools *instance = new Pools();
+  return *instance;
+}
+
+size_t classIndex(size_t size) {
+  return (std::max<size_t>(size, 1) - 1) / EntityPool::kClassGranularity;
+}
+}  // namespace
+
+void *EntityPool::Allocate(size_t size) {
+  if (size > kMaxPooledSize) {
+    return ::operator new(size);
+  }
+  SizeClass &sc = pools().classes[classIndex(size)];
+  std::lock_guard<std::mutex> lock(sc.mutex);
+  if (!sc.freeList) {
+    sc.grow();
+  }
+  FreeBlock *block = sc.freeList;
+  sc.freeList = block->next;
+  sc.stats.allocations++;
+  sc.stats.live++;
+  sc.stats.peakLive = std::max(sc.stats.peakLive, sc.stats.live);
+  return block;
+}
+
+void EntityPool::Free(void *ptr, size_t size) {
+  if (!ptr) return;
+  if (size > kMaxPooledSize) {
+    ::operator delete(ptr);
+    return;
+  }
+  SizeClass &sc = pools().classes[classIndex(size)];
+  std::lock_guard<std::mutex> lock(sc.mutex);
+  FreeBlock *block = static_cast<FreeBlock *>(ptr);
+  block->next = sc.freeList;
+  sc.freeList = block;
+  sc.stats.frees++;
+  sc.stats.live--;
+}
+
+std::vector<EntityPoolStats> EntityPool::GetStats() {
+  std::vector<EntityPoolStats> result;
+  for (SizeClass &sc : pools().classes) {
+    std::lock_guard<std::mutex> lock(sc.mutex);
+    if (sc.stats.allocations > 0) {
+      result.push_back(sc.stats);
+    }
+  }
+  return result;
+}
+
+void EntityPool::PrintStats() {
+  std::cout << "Entity pool:" << std::endl;
+  for (const EntityPoolStats &s : GetStats()) {
+    std::cout << "  " << s.blockSize << "B blocks: live " << s.live
+              << " (peak " << s.peakLive << ") of " << s.capacity << " in "
+              << s.chunks << " chunks, " << s.allocations << " allocs, "
+              << s.frees << " frees" << std::endl;
+  }
+}
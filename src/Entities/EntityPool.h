@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-size-class usage, reported by EntityPool::GetStats().
+struct EntityPoolStats {
+  size_t blockSize = 0;
+  size_t chunks = 0;
+  size_t capacity = 0;    // blocks carved out of chunks so far
+  size_t live = 0;        // blocks currently handed out
+  size_t peakLive = 0;
+  uint64_t allocations = 0;
+  uint64_t frees = 0;
+};
+
+// Fixed-size block pools backing Entity::operator new/delete.
+//
+// Each Entity subclass has a fixed sizeof, so rounding that size up to a
+// 64-byte class gives every subclass (or group of similarly sized
+// subclasses) its own free list. Blocks are carved from chunks that are
+// kept for the lifetime of the process, so bursts of spawns and despawns
+// recycle the same memory instead of churning the global heap. Requests
+// larger than the biggest class fall through to ::operator new.
+class EntityPool {
+ public:
+  static constexpr size_t kClassGranularity = 64;
+  static constexpr size_t kMaxPooledSize = 2048;
+  static constexpr size_t kChunkBytes = 16 * 1024;
+
+  static void *Allocate(size_t size);
+  static void Free(void *ptr, size_t size);
+
+  // Only size classes that have been used are reported.
+  static std::vector<EntityPoolStats> GetStats();
+  static void PrintStats();
+};
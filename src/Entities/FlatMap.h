@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Small associative container for the handful of components/textures an
+// entity carries. The first N entries live inline in the owning object, so
+// a typical entity needs no extra heap nodes; past N everything moves into
+// one vector. Entries keep insertion order and lookup is a linear scan,
+// which beats a tree for these sizes.
+//
+// References returned by find()/operator[] are invalidated by any insert
+// once the map holds N entries: the insert that spills moves everything to
+// the heap, and later ones may reallocate that vector. erase() moves the
+// last entry into the hole, so it invalidates references to that entry too.
+template <typename Key, typename Value, size_t N>
+class FlatMap {
+ public:
+  using value_type = std::pair<Key, Value>;
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + count; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + count; }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  iterator find(const Key &key) {
+    for (iterator it = begin(); it != end(); ++it) {
+      if (it->first == key) return it;
+    }
+    return end();
+  }
+
+  const_iterator find(const Key &key) const {
+    for (const_iterator it = begin(); it != end(); ++it) {
+      if (it->first == key) return it;
+    }
+    return end();
+  }
+
+  bool contains(const Key &key) const { return find(key) != end(); }
+
+  Value &operator[](const Key &key) {
+    iterator it = find(key);
+    if (it != end()) return it->second;
+    return insertNew(key)->second;
+  }
+
+  // Swap-removes the entry, so iteration order is not preserved.
+  bool erase(const Key &key) {
+    iterator it = find(key);
+    if (it == end()) return false;
+    iterator last = end() - 1;
+    if (it != last) *it = std::move(*last);
+    *last = value_type{};
+    count--;
+    if (spilled()) overflow.pop_back();
+    return true;
+  }
+
+  void clear() {
+    inlineItems.fill(value_type{});
+    overflow.clear();
+    count = 0;
+  }
+
+ private:
+  std::array<value_type, N> inlineItems{};
+  std::vector<value_type> overflow;  // holds every entry once spilled
+  size_t count = 0;
+
+  bool spilled() const { return !overflow.empty(); }
+  value_type *data() { return spilled() ? overflow.data() : inlineItems.data(); }
+  const value_type *data() const {
+    return spilled() ? overflow.data() : inlineItems.data();
+  }
+
+  iterator insertNew(const Key &key) {
+    if (count < N) {
+      inlineItems[count] = value_type{key, Value{}};
+      return &inlineItems[count++];
+    }
+    if (!spilled()) {
+      overflow.reserve(N * 2);
+      for (auto &item : inlineItems) overflow.push_back(std::move(item));
+      inlineItems.fill(value_type{});
+    }
+    overflow.push_back(value_type{key, Value{}});
+    count++;
+    return &overflow.back();
+  }
+};
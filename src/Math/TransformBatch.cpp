@@ -0,0 +1,81 @@
+#include "TransformBatch.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRANSFORM_BATCH_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRANSFORM_BATCH_SSE 1
+#endif
+
+void TransformRectsScalar(const vec2 *positions, const vec2 *dimensions,
+                          size_t count, const RectTransform &transform,
+                          RectF *out) {
+  const vec2 t = transform.translate;
+  const vec2 s = transform.scale;
+  for (size_t i = 0; i < count; ++i) {
+    out[i].x = (positions[i].x + t.x) * s.x;
+    out[i].y = (positions[i].y + t.y) * s.y;
+    out[i].w = dimensions[i].x * s.x;
+    out[i].h = dimensions[i].y * s.y;
+  }
+}
+
+void TransformRects(const vec2 *positions, const vec2 *dimensions, size_t count,
+                    const RectTransform &transform, RectF *out) {
+  // The arrays may be null (e.g. an empty vector's data()) when count is 0
+  if (count == 0) {
+    return;
+  }
+  const float *pos = &positions[0].x;
+  const float *dims = &dimensions[0].x;
+  float *dst = &out[0].x;
+  size_t i = 0;
+
+#if defined(TRANSFORM_BATCH_AVX)
+  // Four entities per step: p = x0 y0 x1 y1 | x2 y2 x3 y3, same for d
+  const __m256 t8 = _mm256_setr_ps(
+      transform.translate.x, transform.translate.y, transform.translate.x,
+      transform.translate.y, transform.translate.x, transform.translate.y,
+      transform.translate.x, transform.translate.y);
+  const __m256 s8 = _mm256_setr_ps(
+      transform.scale.x, transform.scale.y, transform.scale.x, transform.scale.y,
+      transform.scale.x, transform.scale.y, transform.scale.x, transform.scale.y);
+  for (; i + 4 <= count; i += 4) {
+    __m256 p = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(pos + 2 * i), t8), s8);
+    __m256 d = _mm256_mul_ps(_mm256_loadu_ps(dims + 2 * i), s8);
+    // r0 | r2 and r1 | r3, then put the lanes back in order
+    __m256 even = _mm256_shuffle_ps(p, d, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 odd = _mm256_shuffle_ps(p, d, _MM_SHUFFLE(3, 2, 3, 2));
+    _mm256_storeu_ps(dst + 4 * i, _mm256_permute2f128_ps(even, odd, 0x20));
+    _mm256_storeu_ps(dst + 4 * i + 8, _mm256_permute2f128_ps(even, odd, 0x31));
+  }
+#elif defined(TRANSFORM_BATCH_SSE)
+  // Two entities per step: p = x0 y0 x1 y1, d = w0 h0 w1 h1
+  const __m128 t4 = _mm_setr_ps(transform.translate.x, transform.translate.y,
+                                transform.translate.x, transform.translate.y);
+  const __m128 s4 = _mm_setr_ps(transform.scale.x, transform.scale.y,
+                                transform.scale.x, transform.scale.y);
+  for (; i + 2 <= count; i += 2) {
+    __m128 p = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(pos + 2 * i), t4), s4);
+    __m128 d = _mm_mul_ps(_mm_loadu_ps(dims + 2 * i), s4);
+    _mm_storeu_ps(dst + 4 * i, _mm_movelh_ps(p, d));
+    _mm_storeu_ps(dst + 4 * i + 4, _mm_movehl_ps(d, p));
+  }
+#endif
+
+  // Tail (or everything, without SIMD)
+  TransformRectsScalar(positions + i, dimensions + i, count - i, transform,
+                       out + i);
+}
+
+const char *TransformRectsPath() {
+#if defined(TRANSFORM_BATCH_AVX)
+  return "avx";
+#elif defined(TRANSFORM_BATCH_SSE)
+  return "sse";
+#else
+  return "scalar";
+#endif
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+
+#include "vec2.h"
+
+// Screen rectangle with the same layout as SDL_FRect, so callers can pass an
+// SDL_FRect array without this header depending on SDL.
+struct RectF {
+  float x, y, w, h;
+};
+
+// dst = ((position + translate) * scale, dimensions * scale)
+struct RectTransform {
+  vec2 translate = {0.0f, 0.0f};
+  vec2 scale = {1.0f, 1.0f};
+};
+
+// Transforms count position/size pairs into rectangles in one pass. Uses AVX
+// when the build enables it (ENGINE_ENABLE_AVX), SSE otherwise on x86, and
+// plain scalar code elsewhere. Inputs and output may be unaligned but must
+// not overlap.
+void TransformRects(const vec2 *positions, const vec2 *dimensions, size_t count,
+                    const RectTransform &transform, RectF *out);
+
+// Reference implementation; same results as TransformRects.
+void TransformRectsScalar(const vec2 *positions, const vec2 *dimensions,
+                          size_t count, const RectTransform &transform,
+                          RectF *out);
+
+// Name of the path TransformRects compiled to ("avx", "sse" or "scalar")
+const char *TransformRectsPath();
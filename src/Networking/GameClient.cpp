@@ -6,6 +6,7 @@
 #include <sstream>
 #include <functional>
 #include <set>
+#include <cstdio>
 
 using namespace std;
 
@@ -190,6 +191,24 @@ void GameClient::Run() {
     auto inputManager = GetInput();
     auto entityMgr = GetEntityManager();
 
+    if (threadedRendering) {
+        // Network, input and entity updates run on the simulation thread;
+        // the main thread only draws, so vsync never stalls the socket
+        RunSplit([this, inputManager, &lastInputSend](float) {
+            ProcessServerMessages();
+            if (inputManager) {
+                inputManager->Update();
+            }
+            Uint32 now = SDL_GetTicks();
+            if (isConnected && (now - lastInputSend) > 50) {
+                SendInputToServer();
+                lastInputSend = now;
+            }
+            frameSignal.Signal();
+        });
+        return;
+    }
+
     // We need to track running state ourselves since it's private in base class
     bool clientRunning = true;
 
@@ -207,24 +226,34 @@ void GameClient::Run() {
             }
         }
         
-        // Process server messages (non-blocking)
-        ProcessServerMessages();
-        std::vector<Entity *> entities;
-        if (entityMgr) {
-            entities = entityMgr->getEntityVectorRef();
-        }
+        using namespace FrameResource;
+        frameGraph.Clear();
+
+        // Process server messages (non-blocking). Entity factories may create
+        // textures, so this stays on the main thread.
+        frameGraph.AddStage("receive", None, Entities | Transforms | NetworkIn, [this]() {
+            ProcessServerMessages();
+        }, true);
 
         // Update input
-        if (inputManager) {
-            inputManager->Update();
-        }
+        frameGraph.AddStage("input", None, Input, [inputManager]() {
+            if (inputManager) {
+                inputManager->Update();
+            }
+        });
         
         // Send input to server periodically (every 50ms)
         if (isConnected && (currentTime - lastInputSend) > 50) {
-            SendInputToServer();
+            frameGraph.AddStage("send", Input, NetworkOut, [this]() { SendInputToServer(); });
             lastInputSend = currentTime;
         }
-        Render(entities);
+        frameGraph.AddStage("render", Entities | Transforms | Input, Screen, [this, entityMgr]() {
+            if (entityMgr) {
+                Render(EntityView::Visible);
+            }
+        }, true);
+        frameGraph.Execute();
+        frameSignal.Signal();
         float delay = std::max(0.0, 1000.0 / 60.0 - deltaTime);
         SDL_Delay(delay);
     }
@@ -237,8 +266,6 @@ void GameClient::Shutdown() {
 }
 
 void GameClient::ProcessStringEntityData(const std::string& entityData) {
-    float offsetX = 0.0f;
-    float offsetY = 0.0f;
     if (entityData.empty()) {
         return;
     }
@@ -260,14 +287,23 @@ void GameClient::ProcessStringEntityData(const std::string& entityData) {
         return;
     }
     
-    std::vector<Entity*> localEntities = entityMgr->getEntityVectorRef();
-    
     // Track which server entities we've seen
     std::set<int> serverEntityIds;
     
     // For each entity from server, find or create corresponding local entity
     for (const std::string& entityLine : entityLines) {
-        // Parse entity data: id,x,y,width,height,velocityX,velocityY,textureState,visible
+        // Camera of an entity: CAM,id,x,y. Only our own player's view matters.
+        if (entityLine.rfind("CAM,", 0) == 0) {
+            int camId = -1;
+            float camX = 0.0f, camY = 0.0f;
+            if (std::sscanf(entityLine.c_str(), "CAM,%d,%f,%f", &camId, &camX, &camY) == 3 &&
+                camId == playerEntityId && playerEntityId != -1) {
+                camera.position = {.x = camX, .y = camY};
+            }
+            continue;
+        }
+
+        // Parse entity data: id,type,x,y,width,height,velocityX,velocityY,textureState,frame,visible
         std::vector<std::string> parts;
         std::stringstream entityStream(entityLine);
         std::string part;
@@ -286,32 +322,22 @@ void GameClient::ProcessStringEntityData(const std::string& entityData) {
         std::string entityType = parts[1];
         float x = std::stof(parts[2]);
         float y = std::stof(parts[3]);
-        if(id == playerEntityId && playerEntityId != -1) {
-            offsetX = std::stof(parts[4]);
-            offsetY = std::stof(parts[5]);
-        }
-        float width = std::stof(parts[6]);
-        float height = std::stof(parts[7]);
-        float velX = std::stof(parts[8]);
-        float velY = std::stof(parts[9]);
-        int textureState = std::stoi(parts[10]);
-        int currentFrame = std::stoi(parts[11]);
-        bool visible = (std::stoi(parts[12]) == 1);
+        float width = std::stof(parts[4]);
+        float height = std::stof(parts[5]);
+        float velX = std::stof(parts[6]);
+        float velY = std::stof(parts[7]);
+        int textureState = std::stoi(parts[8]);
+        int currentFrame = std::stoi(parts[9]);
+        bool visible = (std::stoi(parts[10]) == 1);
         
         // Track this server entity
         serverEntityIds.insert(id);
         
         // Find existing entity with this ID
-        Entity* localEntity = nullptr;
-        for (Entity* entity : localEntities) {
-            if (entity->GetId() == id) {
-                localEntity = entity;
-                break;
-            }
-        }
+        Entity* localEntity = entityMgr->FindById(id);
         
         if (localEntity) {
-            SyncEntityWithStringData(localEntity, x, y, offsetX, offsetY, width, height, velX, velY, textureState, currentFrame, visible);
+            SyncEntityWithStringData(localEntity, x, y, width, height, velX, velY, textureState, currentFrame, visible);
         } else {
             // Try to find a registered entity factory for this type
             auto it = this->entityFactory.find(entityType);
@@ -325,46 +351,36 @@ void GameClient::ProcessStringEntityData(const std::string& entityData) {
             localEntity->entityType = entityType;
             entityMgr->AddEntity(localEntity);
             // Sync with server data (this will override any factory defaults)
-            SyncEntityWithStringData(localEntity, x, y, offsetX, offsetY, width, height, velX, velY, textureState, currentFrame, visible);
+            SyncEntityWithStringData(localEntity, x, y, width, height, velX, velY, textureState, currentFrame, visible);
         }
     }
     
     // Remove any local entities that are no longer on the server
-    auto& entities = entityMgr->getEntityVectorRef();
-    for (auto it = entities.begin(); it != entities.end();) {
-        if(playerEntityId != -1) {
-            (*it)->rendering.offSetX = offsetX;
-            (*it)->rendering.offSetY = offsetY;
-        } else {
-            (*it)->rendering.offSetX = 0.0f;
-            (*it)->rendering.offSetY = 0.0f;
-        }
-        if (serverEntityIds.find((*it)->GetId()) == serverEntityIds.end()) {
-            delete *it;
-            it = entities.erase(it);
-        } else {
-            ++it;
+    std::vector<Entity*> staleEntities;
+    for (Entity* entity : entityMgr->getEntityVectorRef()) {
+        if (serverEntityIds.find(entity->GetId()) == serverEntityIds.end()) {
+            staleEntities.push_back(entity);
         }
     }
+    // RemoveEntity retires the slot so any handle to it resolves to nullptr
+    for (Entity* entity : staleEntities) {
+        entityMgr->RemoveEntity(entity);
+        delete entity;
+    }
 }
 
-void GameClient::SyncEntityWithStringData(Entity* entity, float x, float y, float offSetX, float offSetY, float width, float height, 
+void GameClient::SyncEntityWithStringData(Entity* entity, float x, float y, float width, float height, 
                                          float velX, float velY, int textureState, int currentFrame, bool visible) {
     // Update entity properties from string data
     entity->SetPosition(x, y);
-    entity->rendering.offSetX = offSetX;
-    entity->rendering.offSetY = offSetY;
     entity->dimensions = {.x = width, .y = height};
-    // Update physics component if it exists
-    if (entity->physicsEnabled && entity->hasComponent("physics")) {
-        auto& physics = entity->getComponent<PhysicsComponent>("physics");
-        physics.velocity = {.x = velX, .y = velY};
-    }
+    // Update velocity if the entity has physics (no-op otherwise)
+    entity->SetVelocity(velX, velY);
     
     // Update rendering component
     entity->rendering.currentTextureState = textureState;
     entity->rendering.currentFrame = currentFrame;
-    entity->rendering.isVisible = visible;
+    entity->SetVisible(visible);
 }
 
 void GameClient::RegisterEntity(const std::string& entityType, std::function<Entity*()> constructor) {
@@ -1,5 +1,6 @@
 // GameServer.cpp
 #include "GameServer.h"
+#include "Entities/EntityCommandBuffer.h"
 #include <iostream>
 #include <chrono>
 #include <SDL3/SDL.h>
@@ -8,7 +9,7 @@
 using namespace std;
 
 // GameServer Implementation
-GameServer::GameServer() : GameEngine(true), isServerRunning(false), publisherPort(0), pullPort(0), shouldStop(false), shouldStopWorkers(false) {
+GameServer::GameServer() : GameEngine(true), isServerRunning(false), publisherPort(0), pullPort(0), shouldStop(false) {
     // Initialize ZeroMQ context
     zmqContext = std::make_unique<zmq::context_t>(1);
     publisherSocket = std::make_unique<zmq::socket_t>(*zmqContext, ZMQ_PUB);
@@ -45,43 +46,30 @@ bool GameServer::StartServer(int pubPort, int pullPort) {
     
     isServerRunning = true;
     shouldStop = false;
-    shouldStopWorkers = false;
     
-    // Start message processor thread
-    messageProcessorThread = std::thread(&GameServer::MessageProcessorThread, this);
-    
-    // Start worker threads (simple thread pool)
-    int numWorkers = 4;
-    
-    for (int i = 0; i < numWorkers; ++i) {
-        workerThreads.emplace_back(&GameServer::WorkerThreadFunction, this);
-    }
+    // Start the receive coroutine; it only occupies a worker while messages
+    // are actually being processed
+    ioReactor = std::make_unique<IoReactor>(*zmqContext, jobSystem);
+    ioReactor->Start();
+    Spawn(jobSystem, ReceiveLoop(), &receiveLoopDone);
     
     std::cout << "GameServer started successfully on ports " << pubPort << " (pub) and " << pullPort << " (pull)" << std::endl;
-    std::cout << "Started " << numWorkers << " worker threads" << std::endl;
     return true;
 }
 
 void GameServer::StopServer() {
     shouldStop = true;
-    shouldStopWorkers = true;
-    isServerRunning = false;
-    
-    // Notify all worker threads to stop
-    messageCondition.notify_all();
     
-    // Wait for message processor thread to finish
-    if (messageProcessorThread.joinable()) {
-        messageProcessorThread.join();
-    }
-    
-    // Wait for all worker threads to finish
-    for (auto& workerThread : workerThreads) {
-        if (workerThread.joinable()) {
-            workerThread.join();
+    if (isServerRunning) {
+        isServerRunning = false;
+        
+        // Release the receive coroutine and wait for it to finish
+        if (ioReactor) {
+            ioReactor->Stop();
         }
+        jobSystem.WaitForCounter(receiveLoopDone);
+        ioReactor.reset();
     }
-    workerThreads.clear();
     
     // Close sockets
     if (publisherSocket) {
@@ -110,7 +98,29 @@ void GameServer::BroadcastGameState(const std::string& gameState) {
 }
 
 void GameServer::ProcessClientMessages() {
-
+    {
+        std::lock_guard<std::mutex> lock(actionsMutex);
+        applyingActions.swap(pendingActions);
+    }
+    for (const ClientActions& pending : applyingActions) {
+        Entity* playerEntity = GetPlayerEntity(pending.clientId);
+        if (!playerEntity) {
+            // Player entity doesn't exist yet or was already removed
+            continue;
+        }
+        
+        // Process each action for the client
+        if (pending.actions.size() == 0) {
+            // for idle action
+            playerEntity->OnActivity("");
+        }
+        else {
+            for (const auto& actionName : pending.actions) {
+                playerEntity->OnActivity(actionName);
+            }
+        }
+    }
+    applyingActions.clear();
 }
 
 void GameServer::AddClient(const std::string& clientId) {
@@ -133,41 +143,57 @@ std::vector<std::string> GameServer::GetConnectedClients() {
     return connectedClients;
 }
 
-void GameServer::SetPlayerEntityFactory(std::function<Entity*(SDL_Renderer*)> factory) {
+void GameServer::SetPlayerEntityFactory(std::function<Entity*(AssetManager*)> factory) {
     playerEntityFactory = factory;
 }
 
-Entity* GameServer::SpawnPlayerEntity(const std::string& clientId) {
+void GameServer::SpawnPlayerEntity(const std::string& clientId) {
     if (!playerEntityFactory) {
         std::cerr << "Warning: No player entity factory set. Cannot spawn player for client: " << clientId << std::endl;
-        return nullptr;
+        return;
     }
     
-    // Get the renderer from the game engine
-    SDL_Renderer* renderer = GetRenderer();
-    
-    Entity* playerEntity = playerEntityFactory(renderer);
+    // Textures come from the engine's shared asset cache
+    Entity* playerEntity = playerEntityFactory(GetAssets());
     if (playerEntity) {
-        std::lock_guard<std::mutex> lock(entityMapMutex);
-        clientToEntityMap[clientId] = playerEntity;
-        GetEntityManager()->AddEntity(playerEntity);
-        std::cout << "Spawned player entity for client: " << clientId << " with entity ID: " << playerEntity->GetId() << std::endl;
-        
-        // Send player entity ID back to the client via the message system
-        // We'll send this as a unicast message (but since we're using PUB/SUB, it will broadcast)
-        std::string entityIdMessage = "PLAYER_ENTITY:" + clientId + ":" + std::to_string(playerEntity->GetId());
-        BroadcastGameState(entityIdMessage);
+        uint64_t ticket;
+        {
+            std::lock_guard<std::mutex> lock(entityMapMutex);
+            ticket = ++nextSpawnTicket;
+            pendingPlayerSpawns[clientId] = ticket;
+        }
+        // The entity joins the world at the next tick boundary
+        GetEntityManager()->GetCommandBuffer().Spawn(playerEntity,
+            [this, clientId, ticket](Entity* entity, EntityHandle handle) {
+                std::unique_lock<std::mutex> lock(entityMapMutex);
+                auto pending = pendingPlayerSpawns.find(clientId);
+                if (pending == pendingPlayerSpawns.end() || pending->second != ticket) {
+                    // Client disconnected (or reconnected) before the spawn was applied
+                    lock.unlock();
+                    GetEntityManager()->RemoveEntity(entity);
+                    delete entity;
+                    return;
+                }
+                pendingPlayerSpawns.erase(pending);
+                clientToEntityMap[clientId] = handle;
+                lock.unlock();
+                std::cout << "Spawned player entity for client: " << clientId << " with entity ID: " << entity->GetId() << std::endl;
+                
+                // Send player entity ID back to the client via the message system
+                // We'll send this as a unicast message (but since we're using PUB/SUB, it will broadcast)
+                std::string entityIdMessage = "PLAYER_ENTITY:" + clientId + ":" + std::to_string(entity->GetId());
+                BroadcastGameState(entityIdMessage);
+            });
     }
-    return playerEntity;
 }
 
 void GameServer::DespawnPlayerEntity(const std::string& clientId) {
     std::lock_guard<std::mutex> lock(entityMapMutex);
+    pendingPlayerSpawns.erase(clientId);
     auto it = clientToEntityMap.find(clientId);
     if (it != clientToEntityMap.end()) {
-        Entity* playerEntity = it->second;
-        GetEntityManager()->RemoveEntity(playerEntity);
-        delete playerEntity; // Clean up the entity
+        // Removed and deleted at the next tick boundary; a stale handle is ignored
+        GetEntityManager()->GetCommandBuffer().Despawn(it->second);
         clientToEntityMap.erase(it);
         std::cout << "Despawned player entity for client: " << clientId << std::endl;
     }
@@ -176,50 +202,22 @@ void GameServer::DespawnPlayerEntity(const std::string& clientId) {
 Entity* GameServer::GetPlayerEntity(const std::string& clientId) {
     std::lock_guard<std::mutex> lock(entityMapMutex);
     auto it = clientToEntityMap.find(clientId);
-    return (it != clientToEntityMap.end()) ? it->second : nullptr;
+    return (it != clientToEntityMap.end()) ? GetEntityManager()->Get(it->second) : nullptr;
 }
 
-void GameServer::MessageProcessorThread() {
+Task<> GameServer::ReceiveLoop() {
     while (!shouldStop) {
-        zmq::message_t message;
-        auto result = pullSocket->recv(message, zmq::recv_flags::dontwait);
+        bool readable = co_await ioReactor->Readable(*pullSocket);
+        if (!readable) {
+            break;
+        }
         
-        if (result) {
+        // Drain everything that arrived, then go back to waiting
+        zmq::message_t message;
+        while (!shouldStop && pullSocket->recv(message, zmq::recv_flags::dontwait)) {
             std::string messageStr(static_cast<char*>(message.data()), message.size());
             // std::cout << "Server received message: " << messageStr << std::endl;
-            
-            // Add message to queue for worker threads to process
-            {
-                std::lock_guard<std::mutex> lock(messageQueueMutex);
-                messageQueue.push(messageStr);
-            }
-            messageCondition.notify_one();
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Small delay
-    }
-}
-
-void GameServer::WorkerThreadFunction() {
-    while (!shouldStopWorkers) {
-        std::string message;
-        
-        // Wait for a message to process
-        {
-            std::unique_lock<std::mutex> lock(messageQueueMutex);
-            messageCondition.wait(lock, [this] { 
-                return !messageQueue.empty() || shouldStopWorkers; 
-            });
-            
-            if (shouldStopWorkers) break;
-            
-            if (!messageQueue.empty()) {
-                message = messageQueue.front();
-                messageQueue.pop();
-            }
-        }
-        
-        if (!message.empty()) {
-            ProcessMessage(message);
+            ProcessMessage(messageStr);
         }
     }
 }
@@ -248,7 +246,7 @@ void GameServer::ProcessMessage(const std::string& message) {
             
             // std::cout << "Received actions from " << clientId << ": " << actionsData << std::endl;
             
-            // Process actions and update game state
+            // Queue actions for the next tick
             ProcessClientActions(clientId, actionsData);
         }
     }
@@ -270,22 +268,10 @@ void GameServer::ProcessClientActions(const std::string& clientId, const std::st
         }
     }
     
-    Entity* playerEntity = GetPlayerEntity(clientId);
-    if (!playerEntity) {
-        // Player entity doesn't exist yet or was already removed
-        return;
-    }
-    
-    // Process each action for the client
-    if (actions.size() == 0) {
-        // for idle action
-        playerEntity->OnActivity("");
-    }
-    else {
-        for (const auto& actionName : actions) {
-            playerEntity->OnActivity(actionName);
-        }
-    }
+    // Runs on a JobSystem worker: hand the actions to the main thread
+    // rather than touching the player entity here
+    std::lock_guard<std::mutex> lock(actionsMutex);
+    pendingActions.push_back({clientId, std::move(actions)});
 }
 
 bool GameServer::Initialize(const char* title, int resx, int resy) {
@@ -315,28 +301,54 @@ void GameServer::Run() {
         float deltaTime = (float)(currentTime - lastTime);
         lastTime = currentTime;
         
-        // Get entities from the game engine
+        // Get entities from the game engine, applying spawns/despawns
+        // recorded by the receive loop since the last tick
         auto entityMgr = GetEntityManager();
         std::vector<Entity *> entities;
         if (entityMgr) {
+            entityMgr->FlushCommands();
             entities = entityMgr->getEntityVectorRef();
         }
-        GetRootTimeline()->Update(deltaTime / 1000.0f);
-        // Update the game engine (physics, collisions, etc.)
-        Update(deltaTime, entities);
-        
-        // Process client messages (handled by worker threads)
-        HandleClientConnections();
+        // Apply client actions the receive loop queued since the last tick
+        ProcessClientMessages();
         
         // Check if 10ms have passed since last broadcast
         auto now = std::chrono::steady_clock::now();
         auto timeSinceLastBroadcast = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastBroadcast);
+        bool broadcastDue = timeSinceLastBroadcast.count() >= 10;
         
-        if (timeSinceLastBroadcast.count() >= 10) {
-            std::string gameState = SerializeEntityVector(entities);
-            BroadcastGameState(gameState);
+        // Timeline -> update (physics, collisions, etc.) -> snapshot, with the
+        // previous tick's snapshot broadcast alongside. The send buffer is a
+        // resource of its own, so that stage only orders against network output.
+        using namespace FrameResource;
+        constexpr FrameResourceMask SentSnapshot = User;
+        std::string& sendBuffer = snapshotBuffers[snapshotFront];
+        std::string& serializeBuffer = snapshotBuffers[snapshotFront ^ 1];
+        frameGraph.Clear();
+        if (snapshotPending) {
+            frameGraph.AddStage("broadcast", SentSnapshot, NetworkOut, [this, &sendBuffer]() {
+                BroadcastGameState(sendBuffer);
+            });
+            snapshotPending = false;
+        }
+        frameGraph.AddStage("timeline", None, Time, [this, deltaTime]() {
+            GetRootTimeline()->Update(deltaTime / 1000.0f);
+        });
+        frameGraph.AddStage("update", Time, Entities | Transforms | Contacts, [this, deltaTime, &entities]() {
+            Update(deltaTime, entities);
+        });
+        if (broadcastDue) {
+            frameGraph.AddStage("serialize", Entities | Transforms, Snapshot, [this, &entities, &serializeBuffer]() {
+                serializeBuffer = SerializeEntityVector(entities);
+            });
             lastBroadcast = now;
         }
+        frameGraph.Execute();
+        if (broadcastDue) {
+            snapshotFront ^= 1;
+            snapshotPending = true;
+        }
+        frameSignal.Signal();
 
         float delay = std::max(0.0, 1000.0 / 60.0 - deltaTime);
         SDL_Delay(delay);
@@ -352,25 +364,21 @@ void GameServer::Shutdown() {
 }
 
 std::string GameServer::SerializeEntityVector(const std::vector<Entity*>& entities) {
-    std::stringstream ss;
-    
-    for (size_t i = 0; i < entities.size(); ++i) {
+    // Format each entity's line in parallel, then join them in order.
+    // Entities that own a camera (players) add a CAM line after their own.
+    std::vector<std::string> lines(entities.size());
+    jobSystem.ParallelFor(0, entities.size(), JobSystem::kAutoGrain, [&entities, &lines](size_t i) {
         Entity* entity = entities[i];
         
-        // Format: id,x,y,width,height,velocityX,velocityY,textureState,visible
-        float velX = 0.0f, velY = 0.0f;
-        if (entity->physicsEnabled) {
-            auto& physics = entity->getComponent<PhysicsComponent>("physics");
-            velX = physics.velocity.x;
-            velY = physics.velocity.y;
-        }
+        // Format: id,type,x,y,width,height,velocityX,velocityY,textureState,frame,visible
+        // Zero unless physics is enabled
+        float velX = entity->GetVelocityX(), velY = entity->GetVelocityY();
         
+        std::stringstream ss;
         ss << entity->GetId() << ","
            << entity->entityType << ","
            << entity->position.x << ","
            << entity->position.y << ","
-           << entity->rendering.offSetX << ","
-           << entity->rendering.offSetY << ","
            << entity->dimensions.x << ","
            << entity->dimensions.y << ","
            << velX << ","
@@ -378,13 +386,22 @@ std::string GameServer::SerializeEntityVector(const std::vector<Entity*>& entiti
            << entity->rendering.currentTextureState << ","
            << entity->rendering.currentFrame << ","
            << (entity->rendering.isVisible ? 1 : 0);
+        if (entity->hasComponent(Components::Camera)) {
+            // Format: CAM,id,cameraX,cameraY
+            const vec2& cam = entity->getComponent<vec2>(Components::Camera);
+            ss << "\nCAM," << entity->GetId() << "," << cam.x << "," << cam.y;
+        }
+        lines[i] = ss.str();
+    });
+    
+    std::string result;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        result += lines[i];
         
         // Add newline to separate entities
-        if (i < entities.size() - 1) {
-            ss << "\n";
+        if (i < lines.size() - 1) {
+            result += "\n";
         }
     }
-    
-    std::string result = ss.str();
     return result;
 }
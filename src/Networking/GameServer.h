@@ -1,89 +1,112 @@
-// GameServer.h
-#pragma once
-#include "Core/GameEngine.h"
-#include <zmq.hpp>
-#include <thread>
-#include <vector>
-#include <string>
-#include <mutex>
-#include <unordered_map>
-#include <functional>
-#include <queue>
-
-// GameServer class that inherits from GameEngine
-class GameServer : public GameEngine {
-private:
-    // ZeroMQ context and sockets
-    std::unique_ptr<zmq::context_t> zmqContext;
-    std::unique_ptr<zmq::socket_t> publisherSocket;  // PUB for broadcasting to clients
-    std::unique_ptr<zmq::socket_t> pullSocket;       // PULL for receiving from clients
-    
-    // Server-specific members
-    bool isServerRunning;
-    int publisherPort;
-    int pullPort;
-    std::string publisherAddress;
-    std::string pullAddress;
-    
-    // Connection management
-    std::vector<std::string> connectedClients;
-    std::mutex clientsMutex;
-    
-    // Client-to-entity mapping
-    std::unordered_map<std::string, Entity*> clientToEntityMap;
-    std::mutex entityMapMutex;
-    
-    // Player entity factory - allows developers to specify their own player entity class
-    // Parameters: renderer
-    std::function<Entity*(SDL_Renderer*)> playerEntityFactory;
-    
-    // Simple thread pool for processing client messages
-    std::vector<std::thread> workerThreads;
-    std::queue<std::string> messageQueue;
-    std::mutex messageQueueMutex;
-    std::condition_variable messageCondition;
-    std::atomic<bool> shouldStopWorkers;
-    
-    // Message processing thread
-    std::thread messageProcessorThread;
-    
-    // Thread control
-    bool shouldStop;
-
-public:
-    GameServer();
-    ~GameServer();
-
-    // Server-specific methods
-    bool StartServer(int pubPort, int pullPort);
-    void StopServer();
-    void HandleClientConnections();
-    void BroadcastGameState(const std::string& gameState);
-    void ProcessClientMessages();
-    
-    // Connection management
-    void AddClient(const std::string& clientId);
-    void RemoveClient(const std::string& clientId);
-    std::vector<std::string> GetConnectedClients();
-    
-    // Player entity management
-    void SetPlayerEntityFactory(std::function<Entity*(SDL_Renderer*)> factory);
-    Entity* SpawnPlayerEntity(const std::string& clientId);
-    void DespawnPlayerEntity(const std::string& clientId);
-    Entity* GetPlayerEntity(const std::string& clientId);
-    
-    // Override base class methods if needed
-    bool Initialize(const char* title, int resx, int resy);
-    void Run();
-    void Shutdown();
-    
-    // Signal handling
-    void RequestStop() { shouldStop = true; }
-
-private:
-    void MessageProcessorThread();
-    void WorkerThreadFunction();
-    void ProcessMessage(const std::string& message);
-    void ProcessClientActions(const std::string& clientId, const std::string& actionsData);
-    std::string SerializeEntityVector(const std::vector<Entity*>& entities);
-};
+// GameServer.h
+#pragma once
+#include "Core/GameEngine.h"
+#include "Core/Task.h"
+#include "IoReactor.h"
+#include <zmq.hpp>
+#include <thread>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <unordered_map>
+#include <functional>
+#include <queue>
+
+// GameServer class that inherits from GameEngine
+class GameServer : public GameEngine {
+private:
+    // ZeroMQ context and sockets
+    std::unique_ptr<zmq::context_t> zmqContext;
+    std::unique_ptr<zmq::socket_t> publisherSocket;  // PUB for broadcasting to clients
+    std::unique_ptr<zmq::socket_t> pullSocket;       // PULL for receiving from clients
+    
+    // Server-specific members
+    bool isServerRunning;
+    int publisherPort;
+    int pullPort;
+    std::string publisherAddress;
+    std::string pullAddress;
+    
+    // Connection management
+    std::vector<std::string> connectedClients;
+    std::mutex clientsMutex;
+    
+    // Client-to-entity mapping. Spawns are deferred to the tick boundary, so
+    // a client sits in pendingPlayerSpawns until its entity exists; the
+    // ticket lets a stale spawn notice the client left in the meantime.
+    std::unordered_map<std::string, EntityHandle> clientToEntityMap;
+    std::unordered_map<std::string, uint64_t> pendingPlayerSpawns;
+    uint64_t nextSpawnTicket = 0;
+    std::mutex entityMapMutex;
+    
+    // Player entity factory - allows developers to specify their own player entity class
+    // Parameters: asset manager (shared textures)
+    std::function<Entity*(AssetManager*)> playerEntityFactory;
+    
+    // Client messages are received by a coroutine on the engine's JobSystem;
+    // the reactor parks it until the pull socket is readable
+    std::unique_ptr<IoReactor> ioReactor;
+    JobCounter receiveLoopDone;
+    
+    // Actions parsed by the receive coroutine, in arrival order. Entities
+    // are only touched on the main thread, so they wait here until
+    // ProcessClientMessages applies them at the tick boundary.
+    struct ClientActions {
+        std::string clientId;
+        std::vector<std::string> actions;  // empty means idle
+    };
+    std::vector<ClientActions> pendingActions;
+    std::vector<ClientActions> applyingActions;  // reused by ProcessClientMessages
+    std::mutex actionsMutex;
+    
+    // Snapshots are double-buffered so one tick's broadcast can overlap the
+    // next tick's simulation; front holds the snapshot awaiting send
+    std::string snapshotBuffers[2];
+    int snapshotFront = 0;
+    bool snapshotPending = false;
+    
+    // Thread control
+    std::atomic<bool> shouldStop;
+
+public:
+    GameServer();
+    ~GameServer();
+
+    // Server-specific methods
+    bool StartServer(int pubPort, int pullPort);
+    void StopServer();
+    void HandleClientConnections();
+    void BroadcastGameState(const std::string& gameState);
+    // Applies client actions received since the last call through each
+    // player's OnActivity. Main thread only; Run calls it every tick after
+    // FlushCommands.
+    void ProcessClientMessages();
+    
+    // Connection management
+    void AddClient(const std::string& clientId);
+    void RemoveClient(const std::string& clientId);
+    std::vector<std::string> GetConnectedClients();
+    
+    // Player entity management
+    void SetPlayerEntityFactory(std::function<Entity*(AssetManager*)> factory);
+    // Queues the spawn for the next tick boundary; the entity is mapped to
+    // the client once it exists (see GetPlayerEntity)
+    void SpawnPlayerEntity(const std::string& clientId);
+    void DespawnPlayerEntity(const std::string& clientId);
+    // Main thread only: the entity manager's slots and views are not locked
+    Entity* GetPlayerEntity(const std::string& clientId);
+    
+    // Override base class methods if needed
+    bool Initialize(const char* title, int resx, int resy);
+    void Run();
+    void Shutdown();
+    
+    // Signal handling
+    void RequestStop() { shouldStop = true; }
+
+private:
+    Task<> ReceiveLoop();
+    void ProcessMessage(const std::string& message);
+    void ProcessClientActions(const std::string& clientId, const std::string& actionsData);
+    std::string SerializeEntityVector(const std::vector<Entity*>& entities);
+};
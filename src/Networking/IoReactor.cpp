@@ -0,0 +1,128 @@
+// IoReactor.cpp
+#include "IoReactor.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+IoReactor::IoReactor(zmq::context_t& context, JobSystem& jobSystem)
+    : jobSystem(jobSystem), wakeSend(context, ZMQ_PAIR), wakeRecv(context, ZMQ_PAIR), running(false) {
+    // Unique inproc endpoint per reactor instance
+    std::string endpoint = "inproc://io-reactor-" + std::to_string(reinterpret_cast<uintptr_t>(this));
+    wakeRecv.bind(endpoint);
+    wakeSend.connect(endpoint);
+}
+
+IoReactor::~IoReactor() {
+    Stop();
+    wakeSend.close();
+    wakeRecv.close();
+}
+
+void IoReactor::Start() {
+    if (running) {
+        return;
+    }
+    running = true;
+    thread = std::thread(&IoReactor::Run, this);
+}
+
+void IoReactor::Stop() {
+    if (!running) {
+        return;
+    }
+    {
+        // Flipped under the lock so AddWaiter either sees the reactor stopped
+        // or enqueues before the drain below
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+        Wake();
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    // Release everybody still waiting; they see readable == false
+    std::vector<Waiter> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.swap(waiters);
+    }
+    for (const Waiter& w : pending) {
+        *w.readable = false;
+        auto h = w.handle;
+        jobSystem.Submit([h]() { h.resume(); });
+    }
+}
+
+void IoReactor::AddWaiter(zmq::socket_t& socket, std::coroutine_handle<> handle, bool* readable) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) {
+            waiters.push_back({&socket, handle, readable});
+            Wake();
+            return;
+        }
+    }
+    *readable = false;
+    jobSystem.Submit([handle]() { handle.resume(); });
+}
+
+void IoReactor::Wake() {
+    // Caller holds mutex
+    zmq::message_t ping(1);
+    wakeSend.send(ping, zmq::send_flags::dontwait);
+}
+
+void IoReactor::Run() {
+    std::vector<zmq::pollitem_t> items;
+    std::vector<Waiter> polled;
+
+    while (running) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            polled = waiters;
+        }
+
+        items.clear();
+        items.push_back({wakeRecv.handle(), 0, ZMQ_POLLIN, 0});
+        for (const Waiter& w : polled) {
+            items.push_back({w.socket->handle(), 0, ZMQ_POLLIN, 0});
+        }
+
+        try {
+            // Block until a socket is readable or a new waiter wakes us
+            zmq::poll(items.data(), items.size(), std::chrono::milliseconds(-1));
+        } catch (const std::exception& e) {
+            if (running) std::cerr << "[IoReactor] poll error: " << e.what() << std::endl;
+            continue;
+        }
+
+        if (items[0].revents & ZMQ_POLLIN) {
+            zmq::message_t drain;
+            while (wakeRecv.recv(drain, zmq::recv_flags::dontwait)) {}
+        }
+
+        std::vector<Waiter> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < polled.size(); ++i) {
+                if (!(items[i + 1].revents & ZMQ_POLLIN)) {
+                    continue;
+                }
+                for (auto it = waiters.begin(); it != waiters.end(); ++it) {
+                    if (it->handle == polled[i].handle) {
+                        ready.push_back(*it);
+                        waiters.erase(it);
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (const Waiter& w : ready) {
+            *w.readable = true;
+            auto h = w.handle;
+            jobSystem.Submit([h]() { h.resume(); });
+        }
+    }
+}
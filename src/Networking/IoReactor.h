@@ -0,0 +1,59 @@
+// IoReactor.h
+#pragma once
+#include <zmq.hpp>
+#include <atomic>
+#include <coroutine>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Core/JobSystem.h"
+
+// Multiplexes "socket became readable" waits for coroutines onto a single
+// zmq_poll thread. A coroutine that does
+//
+//     bool ok = co_await reactor.Readable(socket);
+//
+// is parked without holding a worker and resumed on the JobSystem once the
+// socket has input (ok == true) or the reactor is stopped (ok == false).
+// While a coroutine waits, the reactor thread is the only one touching the
+// socket, so ZeroMQ's one-thread-at-a-time rule holds.
+class IoReactor {
+public:
+    IoReactor(zmq::context_t& context, JobSystem& jobSystem);
+    ~IoReactor();
+
+    void Start();
+    void Stop();
+
+    struct ReadableAwaiter {
+        IoReactor& reactor;
+        zmq::socket_t& socket;
+        bool readable = false;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) { reactor.AddWaiter(socket, h, &readable); }
+        bool await_resume() const noexcept { return readable; }
+    };
+
+    ReadableAwaiter Readable(zmq::socket_t& socket) { return {*this, socket}; }
+
+private:
+    struct Waiter {
+        zmq::socket_t* socket;
+        std::coroutine_handle<> handle;
+        bool* readable;
+    };
+
+    void AddWaiter(zmq::socket_t& socket, std::coroutine_handle<> handle, bool* readable);
+    void Wake();
+    void Run();
+
+    JobSystem& jobSystem;
+    zmq::socket_t wakeSend;   // guarded by mutex
+    zmq::socket_t wakeRecv;   // reactor thread only
+
+    std::mutex mutex;
+    std::vector<Waiter> waiters;
+    std::atomic<bool> running;
+    std::thread thread;
+};
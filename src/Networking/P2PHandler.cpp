@@ -1,336 +1,340 @@
-
-#include "P2PHandler.h"
-#include <iostream>
-#include <sstream>
-#include <chrono>
-#include <algorithm>
-#include <cmath>
-
-using clock_type = std::chrono::steady_clock;
-
-static uint64_t nowMs() {
-    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
-        clock_type::now().time_since_epoch()).count();
-}
-
-
-bool P2PHandler::InitializeEngine(const char* title, int w, int h, float timeScale) {
-    if (!engine_.Initialize(title, w, h, timeScale)) {
-        std::cerr << "[P2PMain] Initialize failed\n";
-        return false;
-    }
-    engine_.GetRenderSystem()->SetScalingMode(ScalingMode::PROPORTIONAL);
-    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "1");
-    return true;
-}
-
-bool P2PHandler::Boot(const std::string& trackerRep, const std::string& trackerPub)
-{
-    // Networking
-    node_.setOnPeerMessage([this](const std::string& s){ onPeerMessage(s); });
-    P2PNode::Config cfg; cfg.trackerRep = trackerRep; cfg.trackerPub = trackerPub;
-    if (!node_.start(cfg)) {
-        std::cerr << "[P2PMain] P2PNode start failed\n"; return false;
-    }
-    myId_    = node_.peerId();
-    otherId_ = node_.otherId();
-    authority_ = (otherId_ == -1) || (myId_ < otherId_);
-    std::cout << "[P2PMain] myId=" << myId_ << " otherId=" << otherId_
-              << " authority? " << (authority_ ? "yes" : "no") << "\n";
-
-    if (authority_) {
-        spawnMap(&engine_);
-        Entity* e = spawnPlayer(&engine_, myId_, myId_, authority_);
-        peerToEntity_[myId_] = e;
-        // spawnPlayerFor(myId_, 100, 100);  // authority's own player
-        ready = true;
-        std::lock_guard<std::mutex> lk(peersMtx_);
-        connectedPeers_.push_back(myId_);
-        node_.PublishStateNow(&engine_); // push immediate state so clients see us right away
-    }
-
-    // Bind keys
-    
-    // Announce presence (authority will spawn us on CONNECT)
-    node_.SendConnect(myId_);
-    return true;
-}
-
-void P2PHandler::stop() {
-    node_.SendDisconnect(myId_);
-    node_.stop();
-    engine_.Shutdown();
-}
-
-void P2PHandler::despawnPlayerFor(int peerId) {
-    auto it = peerToEntity_.find(peerId);
-    if (it == peerToEntity_.end()) return;
-    Entity* e = it->second;
-    engine_.GetEntityManager()->RemoveEntity(e);
-    delete e;
-    peerToEntity_.erase(it);
-    std::cout << "[P2PMain] Despawned player for peer " << peerId << "\n";
-    node_.PublishStateNow(&engine_); // propagate removal immediately
-}
-
-
-
-Entity* P2PHandler::ensureEntityFor(const std::string& type, int remoteId) {
-    auto it = idToEntity_.find(remoteId);
-    if (it != idToEntity_.end()) return it->second;
-
-    auto fit = factory_.find(type);
-    if (fit == factory_.end()) {
-        // Fallback to a player entity if type is unknown
-        std::cerr << "[P2PMain] No factory for type: " << type << " -> using default player\n";
-        fit = factory_.find("TestEntity");
-    }
-    if (fit == factory_.end()) return nullptr;
-
-    Entity* e = fit->second(&engine_);
-    engine_.GetEntityManager()->AddEntity(e);
-    idToEntity_[remoteId] = e;
-    return e;
-}
-
-void P2PHandler::processState(const std::string& payload) {
-    std::istringstream lines(payload);
-    std::string line;
-    std::set<int> seen;
-    while (std::getline(lines, line)) {
-        if (line.empty()) continue;
-        std::istringstream ls(line);
-        int rid; std::string type;
-        float x,y,w,h,vx,vy;
-        int texState, frame, vis;
-
-        char comma;
-        if (!(ls >> rid)) continue;
-        if (ls.peek()==',') ls.get();
-        std::getline(ls, type, ',');
-        ls >> x >> comma >> y >> comma >> w >> comma >> h >> comma
-           >> vx >> comma >> vy >> comma >> texState >> comma >> frame >> comma >> vis;
-
-        Entity* e = ensureEntityFor(type, rid);
-        if (!e) continue;
-
-        // Non-visual attributes
-        e->dimensions = {w,h};
-        e->rendering.isVisible  = (vis!=0);
-        e->rendering.currentTextureState = texState;
-
-        // Apply server animation frame to avoid anomalies
-        e->rendering.currentFrame = frame;
-
-        // Smooth target
-        Smooth s; s.tx = x; s.ty = y; s.tvx = vx; s.tvy = vy; s.stamp = nowMs();
-        smooth_[rid] = s;
-
-        seen.insert(rid);
-    }
-    // Remove absent
-    std::vector<int> toErase;
-    for (auto& kv : idToEntity_) {
-        if (!seen.count(kv.first)) {
-            kv.second->rendering.isVisible = false;
-            toErase.push_back(kv.first);
-            smooth_.erase(kv.first);
-        }
-    }
-    for (int rid : toErase) idToEntity_.erase(rid);
-}
-
-
-
-void P2PHandler::onPeerMessage(const std::string& s) {
-    // Authority handles CONNECT/DISCONNECT/ACTIONS
-    if (authority_) {
-        if (s.rfind("CONNECT:",0)==0) {
-            int pid = std::stoi(s.substr(8));
-            {
-                std::lock_guard<std::mutex> lk(peersMtx_);
-                if (std::find(connectedPeers_.begin(), connectedPeers_.end(), pid) == connectedPeers_.end())
-                    connectedPeers_.push_back(pid);
-            }
-            if (peerToEntity_.find(pid) == peerToEntity_.end()) {
-                Entity* e = spawnPlayer(&engine_, pid, myId_, authority_);
-                peerToEntity_[pid] = e;
-                // spawnPlayerFor(pid, 1400, 100);
-                node_.PublishStateNow(&engine_); // push spawn immediately
-            }
-            return;
-        }
-        if (s.rfind("DISCONNECT:",0)==0) {
-            int pid = std::stoi(s.substr(11));
-            {
-                std::lock_guard<std::mutex> lk(peersMtx_);
-                connectedPeers_.erase(std::remove(connectedPeers_.begin(), connectedPeers_.end(), pid),
-                                      connectedPeers_.end());
-            }
-            inputs_.erase(pid);
-            despawnPlayerFor(pid);
-            return;
-        }
-        if (s.rfind("ACTIONS:",0)==0) {
-            // ACTIONS:<peerId>:MOVE_LEFT,MOVE_RIGHT,...
-            size_t a = s.find(':'), b = s.find(':', a+1);
-            if (a!=std::string::npos && b!=std::string::npos) {
-                int pid = std::stoi(s.substr(a+1, b-(a+1)));
-                std::string list = s.substr(b+1);
-                std::vector<std::string> actions;
-                std::istringstream ls(list);
-                std::string tok;
-                while (std::getline(ls, tok, ',')) {
-                    actions.push_back(tok);
-                }
-                inputs_[pid] = actions;
-
-                // Backstop: if we somehow missed CONNECT, spawn on first ACTIONS
-                if (peerToEntity_.find(pid) == peerToEntity_.end()) {
-                    Entity* e = spawnPlayer(&engine_, pid, myId_, authority_);
-                    peerToEntity_[pid] = e;
-                    // spawnPlayerFor(pid, 1400, 100);
-                    node_.PublishStateNow(&engine_);
-                }
-            }
-            return;
-        }
-    }
-
-    // Client: stash STATE for main thread
-    if (!authority_) {
-        if (s.rfind("STATE\n",0)==0) {
-            std::lock_guard<std::mutex> lk(stateMtx_);
-            pendingState_.assign(s.data()+6, s.size()-6);
-            hasPendingState_ = true; // overwrite older snapshot
-        }
-    }
-}
-
-void P2PHandler::Run() {
-    bool running = true;
-    auto lastTick = clock_type::now();
-
-    while (running) {
-        SDL_Event e;
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_EVENT_QUIT || e.type == SDL_EVENT_WINDOW_CLOSE_REQUESTED) {
-                running = false;
-            }
-        }
-
-        auto now = clock_type::now();
-        float dt = std::chrono::duration<float>(now - lastTick).count();
-        lastTick = now;
-
-        engine_.GetInput()->Update();
-
-        // Recompute authority (lowest known ID)
-        otherId_ = node_.otherId();
-        bool nowAuthority = (otherId_ == -1) || (myId_ < otherId_);
-        if (nowAuthority != authority_) {
-            authority_ = nowAuthority;
-            std::cout << "[P2PMain] authority switched -> " << (authority_ ? "authority" : "client") << "\n";
-            // Lazy init if we just became authority
-            if (authority_ && !ready) {
-                spawnMap(&engine_);
-                Entity* e = spawnPlayer(&engine_, myId_, myId_, authority_);
-                peerToEntity_[myId_] = e;
-                // spawnPlayerFor(myId_, 100, 100);
-                if (otherId_ != -1 && peerToEntity_.find(otherId_)==peerToEntity_.end()) {
-                    Entity* e = spawnPlayer(&engine_, otherId_, myId_, authority_);
-                    peerToEntity_[otherId_] = e;
-                    // spawnPlayerFor(otherId_, 1400, 100);
-                }
-                ready = true;
-                node_.PublishStateNow(&engine_);
-                std::cout << "[P2PMain] World initialized after authority switch\n";
-            }
-        }
-
-        // Get active actions
-        std::vector<std::string> activeActions = engine_.GetInput()->GetActiveActions();
-
-        if (authority_) {
-            // Apply inputs to players (including ours)
-            inputs_[myId_] = activeActions;
-
-            for (auto& kv : inputs_) {
-                int pid = kv.first;
-                std::vector<std::string> actions = kv.second;
-                Entity* ePlayer = nullptr;
-                auto it = peerToEntity_.find(pid);
-                if (it != peerToEntity_.end()) ePlayer = it->second;
-                
-                node_.ApplyActions(ePlayer, actions);
-            }
-
-            // Advance game on authority
-            auto& entities = engine_.GetEntityManager()->getEntityVectorRef();
-            for (auto* ent : entities) {
-                ent->Update(dt, engine_.GetInput(), engine_.GetEntityManager());
-                if (ent->hasPhysics) engine_.GetPhysics()->ApplyPhysics(ent, dt);
-            }
-            engine_.GetCollision()->ProcessCollisions(entities);
-
-            // Broadcast STATE ~20Hz
-            uint64_t ms = nowMs();
-            if (ms - lastBroadcastMs_ >= 50) {
-                lastBroadcastMs_ = ms;
-                node_.PublishStateNow(&engine_);
-            }
-
-        } else {
-            // Client: read newest STATE and smooth towards it
-            std::string toApply;
-            {
-                std::lock_guard<std::mutex> lk(stateMtx_);
-                if (hasPendingState_) { toApply.swap(pendingState_); hasPendingState_ = false; }
-            }
-            if (!toApply.empty()) processState(toApply);
-
-            // Smooth positions for all remote entities
-            float alpha = std::min(dt * smoothingHz_, 1.0f);
-            for (auto& kv : idToEntity_) {
-                int rid = kv.first;
-                Entity* e = kv.second;
-                auto it = smooth_.find(rid);
-                if (it != smooth_.end()) {
-                    const Smooth& s = it->second;
-                    float nx = e->position.x + (s.tx - e->position.x) * alpha;
-                    float ny = e->position.y + (s.ty - e->position.y) * alpha;
-                    e->SetPosition(nx, ny);
-                    if (e->physicsEnabled && e->hasComponent("physics")) {
-                        e->getComponent<PhysicsComponent>("physics").velocity = { s.tvx, s.tvy };
-                    }
-                }
-            }
-
-            // Only update non-player types locally to avoid fighting server anim state
-            auto& entities = engine_.GetEntityManager()->getEntityVectorRef();
-            for (auto* ent : entities) {
-                if (ent->entityType == "Platform") {
-                    ent->Update(dt, engine_.GetInput(), engine_.GetEntityManager());
-                }
-            }
-
-            // Send my input ~20Hz
-            uint64_t ms = nowMs();
-            if (ms - lastInputSendMs_ >= 50) {
-                lastInputSendMs_ = ms;
-                node_.SendActions(myId_, activeActions);
-            }
-        }
-
-        // Render
-        auto& ents = engine_.GetEntityManager()->getEntityVectorRef();
-        engine_.Render(ents);
-
-        SDL_Delay(1);
-    }
-
-    // Inform authority we are leaving (if we are a client)
-        if (!authority_) node_.SendDisconnect(myId_);
-
-    stop();
-}
+
+#include "P2PHandler.h"
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+using clock_type = std::chrono::steady_clock;
+
+static uint64_t nowMs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        clock_type::now().time_since_epoch()).count();
+}
+
+
+bool P2PHandler::InitializeEngine(const char* title, int w, int h, float timeScale) {
+    if (!engine_.Initialize(title, w, h, timeScale)) {
+        std::cerr << "[P2PMain] Initialize failed\n";
+        return false;
+    }
+    engine_.GetRenderSystem()->SetScalingMode(ScalingMode::PROPORTIONAL);
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "1");
+    return true;
+}
+
+bool P2PHandler::Boot(const std::string& trackerRep, const std::string& trackerPub)
+{
+    // Networking
+    node_.setOnPeerMessage([this](const std::string& s){ onPeerMessage(s); });
+    P2PNode::Config cfg; cfg.trackerRep = trackerRep; cfg.trackerPub = trackerPub;
+    if (!node_.start(cfg)) {
+        std::cerr << "[P2PMain] P2PNode start failed\n"; return false;
+    }
+    myId_    = node_.peerId();
+    otherId_ = node_.otherId();
+    authority_ = (otherId_ == -1) || (myId_ < otherId_);
+    std::cout << "[P2PMain] myId=" << myId_ << " otherId=" << otherId_
+              << " authority? " << (authority_ ? "yes" : "no") << "\n";
+
+    if (authority_) {
+        spawnMap(&engine_);
+        Entity* e = spawnPlayer(&engine_, myId_, myId_, authority_);
+        peerToEntity_[myId_] = e ? e->GetHandle() : EntityHandle{};
+        // spawnPlayerFor(myId_, 100, 100);  // authority's own player
+        ready = true;
+        std::lock_guard<std::mutex> lk(peersMtx_);
+        connectedPeers_.push_back(myId_);
+        node_.PublishStateNow(&engine_); // push immediate state so clients see us right away
+    }
+
+    // Bind keys
+    
+    // Announce presence (authority will spawn us on CONNECT)
+    node_.SendConnect(myId_);
+    return true;
+}
+
+void P2PHandler::stop() {
+    node_.SendDisconnect(myId_);
+    node_.stop();
+    engine_.Shutdown();
+}
+
+void P2PHandler::despawnPlayerFor(int peerId) {
+    auto it = peerToEntity_.find(peerId);
+    if (it == peerToEntity_.end()) return;
+    Entity* e = engine_.GetEntityManager()->Get(it->second);
+    if (e) {
+        engine_.GetEntityManager()->RemoveEntity(e);
+        delete e;
+    }
+    peerToEntity_.erase(it);
+    std::cout << "[P2PMain] Despawned player for peer " << peerId << "\n";
+    node_.PublishStateNow(&engine_); // propagate removal immediately
+}
+
+
+
+Entity* P2PHandler::ensureEntityFor(const std::string& type, int remoteId) {
+    auto it = idToEntity_.find(remoteId);
+    if (it != idToEntity_.end()) {
+        // Handles go stale if the entity was removed behind our back
+        if (Entity* e = engine_.GetEntityManager()->Get(it->second)) return e;
+        idToEntity_.erase(it);
+    }
+
+    auto fit = factory_.find(type);
+    if (fit == factory_.end()) {
+        // Fallback to a player entity if type is unknown
+        std::cerr << "[P2PMain] No factory for type: " << type << " -> using default player\n";
+        fit = factory_.find("TestEntity");
+    }
+    if (fit == factory_.end()) return nullptr;
+
+    Entity* e = fit->second(&engine_);
+    idToEntity_[remoteId] = engine_.GetEntityManager()->AddEntity(e);
+    return e;
+}
+
+void P2PHandler::processState(const std::string& payload) {
+    std::istringstream lines(payload);
+    std::string line;
+    std::set<int> seen;
+    while (std::getline(lines, line)) {
+        if (line.empty()) continue;
+        std::istringstream ls(line);
+        int rid; std::string type;
+        float x,y,w,h,vx,vy;
+        int texState, frame, vis;
+
+        char comma;
+        if (!(ls >> rid)) continue;
+        if (ls.peek()==',') ls.get();
+        std::getline(ls, type, ',');
+        ls >> x >> comma >> y >> comma >> w >> comma >> h >> comma
+           >> vx >> comma >> vy >> comma >> texState >> comma >> frame >> comma >> vis;
+
+        Entity* e = ensureEntityFor(type, rid);
+        if (!e) continue;
+
+        // Non-visual attributes
+        e->dimensions = {w,h};
+        e->SetVisible(vis!=0);
+        e->rendering.currentTextureState = texState;
+
+        // Apply server animation frame to avoid anomalies
+        e->rendering.currentFrame = frame;
+
+        // Smooth target
+        Smooth s; s.tx = x; s.ty = y; s.tvx = vx; s.tvy = vy; s.stamp = nowMs();
+        smooth_[rid] = s;
+
+        seen.insert(rid);
+    }
+    // Remove absent
+    std::vector<int> toErase;
+    for (auto& kv : idToEntity_) {
+        if (!seen.count(kv.first)) {
+            if (Entity* e = engine_.GetEntityManager()->Get(kv.second)) e->SetVisible(false);
+            toErase.push_back(kv.first);
+            smooth_.erase(kv.first);
+        }
+    }
+    for (int rid : toErase) idToEntity_.erase(rid);
+}
+
+
+
+void P2PHandler::onPeerMessage(const std::string& s) {
+    // Authority handles CONNECT/DISCONNECT/ACTIONS
+    if (authority_) {
+        if (s.rfind("CONNECT:",0)==0) {
+            int pid = std::stoi(s.substr(8));
+            {
+                std::lock_guard<std::mutex> lk(peersMtx_);
+                if (std::find(connectedPeers_.begin(), connectedPeers_.end(), pid) == connectedPeers_.end())
+                    connectedPeers_.push_back(pid);
+            }
+            if (peerToEntity_.find(pid) == peerToEntity_.end()) {
+                Entity* e = spawnPlayer(&engine_, pid, myId_, authority_);
+                peerToEntity_[pid] = e ? e->GetHandle() : EntityHandle{};
+                // spawnPlayerFor(pid, 1400, 100);
+                node_.PublishStateNow(&engine_); // push spawn immediately
+            }
+            return;
+        }
+        if (s.rfind("DISCONNECT:",0)==0) {
+            int pid = std::stoi(s.substr(11));
+            {
+                std::lock_guard<std::mutex> lk(peersMtx_);
+                connectedPeers_.erase(std::remove(connectedPeers_.begin(), connectedPeers_.end(), pid),
+                                      connectedPeers_.end());
+            }
+            inputs_.erase(pid);
+            despawnPlayerFor(pid);
+            return;
+        }
+        if (s.rfind("ACTIONS:",0)==0) {
+            // ACTIONS:<peerId>:MOVE_LEFT,MOVE_RIGHT,...
+            size_t a = s.find(':'), b = s.find(':', a+1);
+            if (a!=std::string::npos && b!=std::string::npos) {
+                int pid = std::stoi(s.substr(a+1, b-(a+1)));
+                std::string list = s.substr(b+1);
+                std::vector<std::string> actions;
+                std::istringstream ls(list);
+                std::string tok;
+                while (std::getline(ls, tok, ',')) {
+                    actions.push_back(tok);
+                }
+                inputs_[pid] = actions;
+
+                // Backstop: if we somehow missed CONNECT, spawn on first ACTIONS
+                if (peerToEntity_.find(pid) == peerToEntity_.end()) {
+                    Entity* e = spawnPlayer(&engine_, pid, myId_, authority_);
+                    peerToEntity_[pid] = e ? e->GetHandle() : EntityHandle{};
+                    // spawnPlayerFor(pid, 1400, 100);
+                    node_.PublishStateNow(&engine_);
+                }
+            }
+            return;
+        }
+    }
+
+    // Client: stash STATE for main thread
+    if (!authority_) {
+        if (s.rfind("STATE\n",0)==0) {
+            std::lock_guard<std::mutex> lk(stateMtx_);
+            pendingState_.assign(s.data()+6, s.size()-6);
+            hasPendingState_ = true; // overwrite older snapshot
+        }
+    }
+}
+
+void P2PHandler::Run() {
+    bool running = true;
+    auto lastTick = clock_type::now();
+
+    while (running) {
+        SDL_Event e;
+        while (SDL_PollEvent(&e)) {
+            if (e.type == SDL_EVENT_QUIT || e.type == SDL_EVENT_WINDOW_CLOSE_REQUESTED) {
+                running = false;
+            }
+        }
+
+        auto now = clock_type::now();
+        float dt = std::chrono::duration<float>(now - lastTick).count();
+        lastTick = now;
+
+        engine_.GetInput()->Update();
+
+        // Recompute authority (lowest known ID)
+        otherId_ = node_.otherId();
+        bool nowAuthority = (otherId_ == -1) || (myId_ < otherId_);
+        if (nowAuthority != authority_) {
+            authority_ = nowAuthority;
+            std::cout << "[P2PMain] authority switched -> " << (authority_ ? "authority" : "client") << "\n";
+            // Lazy init if we just became authority
+            if (authority_ && !ready) {
+                spawnMap(&engine_);
+                Entity* e = spawnPlayer(&engine_, myId_, myId_, authority_);
+                peerToEntity_[myId_] = e ? e->GetHandle() : EntityHandle{};
+                // spawnPlayerFor(myId_, 100, 100);
+                if (otherId_ != -1 && peerToEntity_.find(otherId_)==peerToEntity_.end()) {
+                    Entity* e = spawnPlayer(&engine_, otherId_, myId_, authority_);
+                    peerToEntity_[otherId_] = e ? e->GetHandle() : EntityHandle{};
+                    // spawnPlayerFor(otherId_, 1400, 100);
+                }
+                ready = true;
+                node_.PublishStateNow(&engine_);
+                std::cout << "[P2PMain] World initialized after authority switch\n";
+            }
+        }
+
+        // Get active actions
+        std::vector<std::string> activeActions = engine_.GetInput()->GetActiveActions();
+
+        if (authority_) {
+            // Apply inputs to players (including ours)
+            inputs_[myId_] = activeActions;
+
+            for (auto& kv : inputs_) {
+                int pid = kv.first;
+                std::vector<std::string> actions = kv.second;
+                Entity* ePlayer = nullptr;
+                auto it = peerToEntity_.find(pid);
+                if (it != peerToEntity_.end()) ePlayer = engine_.GetEntityManager()->Get(it->second);
+                
+                node_.ApplyActions(ePlayer, actions);
+            }
+
+            // Advance game on authority
+            auto& entities = engine_.GetEntityManager()->getEntityVectorRef();
+            for (auto* ent : entities) {
+                ent->Update(dt, engine_.GetInput(), engine_.GetEntityManager());
+                if (ent->hasPhysics) engine_.GetPhysics()->ApplyPhysics(ent, dt);
+            }
+            engine_.GetCollision()->ProcessCollisions(
+                engine_.GetEntityManager()->GetView(EntityView::Collidable));
+
+            // Broadcast STATE ~20Hz
+            uint64_t ms = nowMs();
+            if (ms - lastBroadcastMs_ >= 50) {
+                lastBroadcastMs_ = ms;
+                node_.PublishStateNow(&engine_);
+            }
+
+        } else {
+            // Client: read newest STATE and smooth towards it
+            std::string toApply;
+            {
+                std::lock_guard<std::mutex> lk(stateMtx_);
+                if (hasPendingState_) { toApply.swap(pendingState_); hasPendingState_ = false; }
+            }
+            if (!toApply.empty()) processState(toApply);
+
+            // Smooth positions for all remote entities
+            float alpha = std::min(dt * smoothingHz_, 1.0f);
+            for (auto& kv : idToEntity_) {
+                int rid = kv.first;
+                Entity* e = engine_.GetEntityManager()->Get(kv.second);
+                if (!e) continue;
+                auto it = smooth_.find(rid);
+                if (it != smooth_.end()) {
+                    const Smooth& s = it->second;
+                    float nx = e->position.x + (s.tx - e->position.x) * alpha;
+                    float ny = e->position.y + (s.ty - e->position.y) * alpha;
+                    e->SetPosition(nx, ny);
+                    e->SetVelocity(s.tvx, s.tvy);  // no-op without physics
+                }
+            }
+
+            // Only update non-player types locally to avoid fighting server anim state
+            auto& entities = engine_.GetEntityManager()->getEntityVectorRef();
+            for (auto* ent : entities) {
+                if (ent->entityType == "Platform") {
+                    ent->Update(dt, engine_.GetInput(), engine_.GetEntityManager());
+                }
+            }
+
+            // Send my input ~20Hz
+            uint64_t ms = nowMs();
+            if (ms - lastInputSendMs_ >= 50) {
+                lastInputSendMs_ = ms;
+                node_.SendActions(myId_, activeActions);
+            }
+        }
+
+        // Render
+        engine_.Render(EntityView::Visible);
+
+        SDL_Delay(1);
+    }
+
+    // Inform authority we are leaving (if we are a client)
+        if (!authority_) node_.SendDisconnect(myId_);
+
+    stop();
+}
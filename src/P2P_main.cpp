@@ -11,21 +11,14 @@
 
 void p_makeMap(GameEngine* eng) {
 
-    Platform* platform1 = new Platform(300, 800, 300, 75, false, eng->GetRootTimeline(), eng->GetRenderer());
+    Platform* platform1 = new Platform(300, 800, 300, 75, false, eng->GetRootTimeline(), eng->GetAssets());
     // platform1 has collision enabled but no physics (static platform)
     eng->GetEntityManager()->AddEntity(platform1);
 
-    Platform* platform2 = new Platform(800, 650, 300, 75, true, eng->GetRootTimeline(), eng->GetRenderer());
+    Platform* platform2 = new Platform(800, 650, 300, 75, true, eng->GetRootTimeline(), eng->GetAssets());
     // platform2 has collision and physics enabled (moving platform)
     eng->GetEntityManager()->AddEntity(platform2);
-
-    SDL_Texture* platformTexture = LoadTexture(eng->GetRenderer(),
-        "media/cartooncrypteque_platform_basicground_idle.bmp");
-    if (platformTexture) {
-        Texture tex = { platformTexture, 1, 1, 200, 20, true };
-        platform1->SetTexture(0, &tex);
-        platform2->SetTexture(0, &tex);
-    }
+    // Platform textures come from the shared asset cache in the constructor
     std::cout << "[P2PMain] World spawned (2 platforms)\n";
 }
 
@@ -35,15 +28,8 @@ Entity* p_makePlayer(GameEngine* eng, int peerId, int myId, bool auth) {
                  ? new Timeline(4.0, eng->GetRootTimeline())
                  : eng->GetRootTimeline();
 
-    TestEntity* e = new TestEntity(100, 100, tl, eng->GetRenderer());
-    // TestEntity already enables physics in its constructor
-
-    SDL_Texture* entityTexture = LoadTexture(eng->GetRenderer(),
-        "media/cartooncrypteque_character_skellywithahat_idleright.bmp");
-    if (entityTexture) {
-        Texture tex = { entityTexture, 8, 0, 512, 512, true };
-        e->SetTexture(0, &tex);
-    }
+    TestEntity* e = new TestEntity(100, 100, tl, eng->GetAssets());
+    // TestEntity already enables physics and loads its texture in its constructor
 
     eng->GetEntityManager()->AddEntity(e);
     return e;
@@ -57,12 +43,8 @@ int main() {
     handler.spawnPlayer = p_makePlayer;
     // Factories used by clients to reconstruct entities from STATE
     auto makePlayer = [](GameEngine* ge) -> Entity* {
-        auto* e = new TestEntity(100, 100, ge->GetRootTimeline(), ge->GetRenderer());
-        // TestEntity already enables physics in its constructor
-        SDL_Texture* t = LoadTexture(ge->GetRenderer(),
-            "media/cartooncrypteque_character_skellywithahat_idleright.bmp");
-        if (t) { Texture tex = { t, 8, 0, 512, 512, true }; e->SetTexture(0, &tex); }
-        return e;
+        // TestEntity already enables physics and loads its texture in its constructor
+        return new TestEntity(100, 100, ge->GetRootTimeline(), ge->GetAssets());
     };
     handler.factory_["TestEntity"] = makePlayer;
     handler.factory_["Player"]     = makePlayer;
@@ -70,11 +52,8 @@ int main() {
     handler.factory_["Skeleton"]   = makePlayer;
 
     handler.factory_["Platform"] = [](GameEngine* eng) -> Entity* {
-        Platform* p = new Platform(0,0,200,20,false, eng->GetRootTimeline(), eng->GetRenderer());
         // Platform has collision enabled but no physics (static platform)
-        SDL_Texture* t = LoadTexture(eng->GetRenderer(), "media/cartooncrypteque_platform_basicground_idle.bmp");
-        if (t) { Texture tex = { t, 1, 1, 200, 20, true }; p->SetTexture(0, &tex); }
-        return p;
+        return new Platform(0,0,200,20,false, eng->GetRootTimeline(), eng->GetAssets());
     };
 
     handler.GetEngine()->GetInput()->AddAction("MOVE_LEFT",  SDL_SCANCODE_A);
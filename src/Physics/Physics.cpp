@@ -1,36 +1,50 @@
-#include "Physics.h"
-#include "Entities/Entity.h"
-
-void PhysicsSystem::ApplyPhysics(Entity *entity, float deltaTime) {
-  if (!entity->physicsEnabled)
-    return;
-
-  // Check if entity is kinematic (static)
-  if (entity->collisionEnabled && 
-      entity->getComponent<CollisionComponent>("collision").isKinematic)
-    return;
-
-  PhysicsComponent& physics = entity->getComponent<PhysicsComponent>("physics");
-  physics.velocity = add(physics.velocity, mul(deltaTime, physics.force));
-  entity->position = add(entity->position, mul(deltaTime, physics.velocity));
-}
-
-void PhysicsSystem::ApplyPhysicsMultithreaded(const std::vector<Entity*>& entities) {
-  if (entities.empty()) {
-    return;
-  }
-
-  // Clear the persistent job queue
-  jobSystem.ClearJobs();
-  
-  // Add all physics jobs to the persistent queue
-  for (auto &entity : entities) {
-    float entityDeltaTime = entity->timeline->getDeltaTime();
-    jobSystem.AddJob([this, entity, entityDeltaTime]() {
-      ApplyPhysics(entity, entityDeltaTime);
-    });
-  }
-  
-  // Execute all jobs using the persistent queue
-  jobSystem.ExecuteJobs();
-}
+#include "Physics.h"
+#include "Entities/Entity.h"
+
+namespace {
+// Semi-implicit Euler on one EntityColumns row
+inline void integrate(uint32_t row, float deltaTime) {
+  vec2 &velocity = EntityColumns::Velocity(row);
+  vec2 &position = EntityColumns::Position(row);
+  velocity = add(velocity, mul(deltaTime, EntityColumns::Force(row)));
+  position = add(position, mul(deltaTime, velocity));
+}
+}  // namespace
+
+void PhysicsSystem::ApplyPhysics(Entity *entity, float deltaTime) {
+  if (!entity->physicsEnabled)
+    return;
+
+  // Check if entity is kinematic (static)
+  if (entity->collisionEnabled && 
+      entity->getComponent<CollisionComponent>(Components::Collision).isKinematic)
+    return;
+
+  integrate(entity->GetColumnRow(), deltaTime);
+}
+
+void PhysicsSystem::ApplyPhysicsMultithreaded(const std::vector<Entity*>& entities) {
+  if (entities.empty()) {
+    return;
+  }
+
+  // Chunked over the entity range; no per-entity job allocation
+  jobSystem.ParallelFor(0, entities.size(), JobSystem::kAutoGrain,
+                        [this, &entities](size_t i) {
+    Entity *entity = entities[i];
+    ApplyPhysics(entity, entity->timeline->getDeltaTime());
+  });
+}
+
+void PhysicsSystem::ApplyPhysicsMultithreaded(const std::vector<uint32_t>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+
+  // Reads and writes only the columns; the Entity objects are not touched
+  jobSystem.ParallelFor(0, rows.size(), JobSystem::kAutoGrain,
+                        [&rows](size_t i) {
+    const uint32_t row = rows[i];
+    integrate(row, EntityColumns::TimelineOf(row)->getDeltaTime());
+  });
+}
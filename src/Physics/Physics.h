@@ -1,15 +1,21 @@
-#pragma once
-#include "Entities/Entity.h"
-#include "Core/JobSystem.h"
-#include <vector>
-
-class PhysicsSystem {
- public:
-  PhysicsSystem(int numThreads) : jobSystem(numThreads) {}
-
-  void ApplyPhysics(Entity *entity, float deltaTime);
-  void ApplyPhysicsMultithreaded(const std::vector<Entity*>& entities);
-
- private:
-  JobSystem jobSystem;
-};
+#pragma once
+#include "Entities/Entity.h"
+#include "Core/JobSystem.h"
+#include <vector>
+
+class PhysicsSystem {
+ public:
+  // Runs on the engine's pool rather than owning one, so there is a single
+  // set of worker threads per process
+  explicit PhysicsSystem(JobSystem &jobSystem) : jobSystem(jobSystem) {}
+
+  void ApplyPhysics(Entity *entity, float deltaTime);
+  void ApplyPhysicsMultithreaded(const std::vector<Entity*>& entities);
+  // Same integration over EntityColumns rows, e.g.
+  // EntityManager::GetViewRows(EntityView::Simulated). Every row must be
+  // physics-enabled, non-kinematic and have a timeline.
+  void ApplyPhysicsMultithreaded(const std::vector<uint32_t>& rows);
+
+ private:
+  JobSystem &jobSystem;
+};
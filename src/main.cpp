@@ -1,71 +1,43 @@
-#include "Core/GameEngine.h"
-// #include <memory>
-#include "main.h"
-
-int main(int argc, char *argv[]) {
-  (void)argc;
-  (void)argv;
-
-  GameEngine engine;
-  if (!engine.Initialize("Game Engine", 1800, 1000, 1.0f)) {
-    return 1;
-  }
-  engine.GetRenderSystem()->SetScalingMode(ScalingMode::PROPORTIONAL);
-  Timeline *halfTimeline = new Timeline(0.5, engine.GetRootTimeline());
-  Timeline *doubleTimeline = new Timeline(2.0, engine.GetRootTimeline());
-  (void)doubleTimeline; // unused for now
-  
-  // Create entities
-  TestEntity *testEntity = new TestEntity(100, 100, engine.GetRootTimeline(), engine.GetRenderer());
-  // TestEntity already enables physics in its constructor
-
-  Platform *platform1 = new Platform(300, 800, 300, 75, false, halfTimeline, engine.GetRenderer());
-  // platform1 has collision enabled but no physics (static platform)
-
-  Platform *platform2 = new Platform(800, 650, 300, 75, true, engine.GetRootTimeline(), engine.GetRenderer());
-  // platform2 has collision and physics enabled (moving platform)
-
-  // Add entities to the engine
-  engine.GetEntityManager()->AddEntity(testEntity);
-  engine.GetEntityManager()->AddEntity(platform1);
-  engine.GetEntityManager()->AddEntity(platform2);
-
-  SDL_Texture *entityTexture = LoadTexture(
-      engine.GetRenderer(),
-      "media/cartooncrypteque_character_skellywithahat_idleright.bmp");
-  if (entityTexture) {
-    Texture tex = {
-      .sheet = entityTexture,
-      .num_frames_x = 8,
-      .num_frames_y = 0,
-      .frame_width = 512,
-      .frame_height = 512,
-      .loop = true
-    };
-    testEntity->SetTexture(0, &tex);
-  }
-
-  SDL_Texture *platformTexture =
-      LoadTexture(engine.GetRenderer(),
-                  "media/cartooncrypteque_platform_basicground_idle.bmp");
-  if (platformTexture) {
-    Texture tex = {
-      .sheet = platformTexture,
-      .num_frames_x = 1,
-      .num_frames_y = 1,
-      .frame_width = 200,
-      .frame_height = 20,
-      .loop = true
-    };
-    platform1->SetTexture(0, &tex);
-    platform2->SetTexture(0, &tex);
-  }
-
-  engine.Run();
-
-  SDL_Log("Cleaning up resources...");
-  engine.Shutdown();
-  SDL_Log("Shutdown complete. Exiting.");
-
-  return 0;
+#include "Core/GameEngine.h"
+// #include <memory>
+#include "main.h"
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+
+  GameEngine engine;
+  if (!engine.Initialize("Game Engine", 1800, 1000, 1.0f)) {
+    return 1;
+  }
+  engine.GetRenderSystem()->SetScalingMode(ScalingMode::PROPORTIONAL);
+  Timeline *halfTimeline = new Timeline(0.5, engine.GetRootTimeline());
+  Timeline *doubleTimeline = new Timeline(2.0, engine.GetRootTimeline());
+  (void)doubleTimeline; // unused for now
+  
+  // Create entities
+  TestEntity *testEntity = new TestEntity(100, 100, engine.GetRootTimeline(), engine.GetAssets());
+  // TestEntity already enables physics and loads its texture in its constructor
+
+  Platform *platform1 = new Platform(300, 800, 300, 75, false, halfTimeline, engine.GetAssets());
+  // platform1 has collision enabled but no physics (static platform)
+
+  Platform *platform2 = new Platform(800, 650, 300, 75, true, engine.GetRootTimeline(), engine.GetAssets());
+  // platform2 has collision and physics enabled (moving platform)
+
+  // Add entities to the engine
+  engine.GetEntityManager()->AddEntity(testEntity);
+  engine.GetEntityManager()->AddEntity(platform1);
+  engine.GetEntityManager()->AddEntity(platform2);
+
+  // Entity constructors share textures through engine.GetAssets(), so the
+  // two platforms reference one copy of the platform sheet
+
+  engine.Run();
+
+  SDL_Log("Cleaning up resources...");
+  engine.Shutdown();
+  SDL_Log("Shutdown complete. Exiting.");
+
+  return 0;
 }
\ No newline at end of file
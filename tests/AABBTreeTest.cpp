@@ -0,0 +1,151 @@
+// AABBTree spatial queries: Raycast hits, misses and filters, QueryAABB and
+// QueryPoint against known boxes, and which entities they may return
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Check.h"
+#include "Collision/AABBTree.h"
+
+namespace {
+
+Entity *addBox(EntityManager &manager, std::vector<Entity *> &entities, float x,
+               float y, float w, float h) {
+  Entity *entity = new Entity();
+  entity->position = {x, y};
+  entity->dimensions = {w, h};
+  manager.AddEntity(entity);
+  entities.push_back(entity);
+  return entity;
+}
+
+bool near(float a, float b) { return std::fabs(a - b) < 1e-4f; }
+
+bool contains(const std::vector<Entity *> &found, const Entity *entity) {
+  return std::find(found.begin(), found.end(), entity) != found.end();
+}
+
+}  // namespace
+
+int main() {
+  EntityManager manager;
+  std::vector<Entity *> entities;
+  // Three boxes in a row along y = 0..20, and one off to the side
+  Entity *first = addBox(manager, entities, 100.0f, 0.0f, 20.0f, 20.0f);
+  Entity *second = addBox(manager, entities, 200.0f, 0.0f, 20.0f, 20.0f);
+  Entity *third = addBox(manager, entities, 300.0f, 0.0f, 20.0f, 20.0f);
+  Entity *side = addBox(manager, entities, 200.0f, 500.0f, 50.0f, 50.0f);
+
+  AABBTree tree;
+  tree.Update(entities);
+  CHECK(tree.GetProxyCount() == 4);
+
+  // Hit: the closest box along the ray, entered through its left face
+  RaycastHit hit;
+  CHECK(tree.Raycast({0.0f, 10.0f}, {400.0f, 10.0f}, hit));
+  CHECK(hit.entity == first);
+  CHECK(near(hit.fraction, 0.25f));
+  CHECK(near(hit.point.x, 100.0f) && near(hit.point.y, 10.0f));
+  CHECK(hit.normal.x == -1.0f && hit.normal.y == 0.0f);
+
+  // The same ray backwards hits the last box through its right face
+  CHECK(tree.Raycast({400.0f, 10.0f}, {0.0f, 10.0f}, hit));
+  CHECK(hit.entity == third);
+  CHECK(near(hit.point.x, 320.0f));
+  CHECK(hit.normal.x == 1.0f && hit.normal.y == 0.0f);
+
+  // Vertical ray into the side box from above
+  CHECK(tree.Raycast({225.0f, 300.0f}, {225.0f, 600.0f}, hit));
+  CHECK(hit.entity == side && near(hit.point.y, 500.0f));
+  CHECK(hit.normal.x == 0.0f && hit.normal.y == -1.0f);
+
+  // Misses: passing above the row, stopping short of it, and an empty tree
+  CHECK(!tree.Raycast({0.0f, -50.0f}, {400.0f, -50.0f}, hit));
+  CHECK(hit.entity == nullptr && hit.fraction == 1.0f);
+  CHECK(!tree.Raycast({0.0f, 10.0f}, {90.0f, 10.0f}, hit));
+  AABBTree empty;
+  CHECK(!empty.Raycast({0.0f, 10.0f}, {400.0f, 10.0f}, hit));
+
+  // Starting inside a box: fraction 0 and no normal
+  CHECK(tree.Raycast({110.0f, 10.0f}, {400.0f, 10.0f}, hit));
+  CHECK(hit.entity == first && hit.fraction == 0.0f);
+  CHECK(hit.normal.x == 0.0f && hit.normal.y == 0.0f);
+
+  // Filter: skipped entities let the ray through to the next one
+  const EntityFilter notFirst = [first](Entity *entity) { return entity != first; };
+  CHECK(tree.Raycast({0.0f, 10.0f}, {400.0f, 10.0f}, hit, notFirst));
+  CHECK(hit.entity == second && near(hit.point.x, 200.0f));
+  const EntityFilter none = [](Entity *) { return false; };
+  CHECK(!tree.Raycast({0.0f, 10.0f}, {400.0f, 10.0f}, hit, none));
+
+  // QueryAABB: overlapping boxes only, touching edges count
+  std::vector<Entity *> found;
+  tree.QueryAABB(SDL_FRect{150.0f, 5.0f, 160.0f, 10.0f}, found);
+  CHECK(found.size() == 2 && contains(found, second) && contains(found, third));
+  found.clear();
+  tree.QueryAABB(SDL_FRect{120.0f, 20.0f, 10.0f, 10.0f}, found);
+  CHECK(found.size() == 1 && found[0] == first);
+  found.clear();
+  tree.QueryAABB(SDL_FRect{0.0f, 100.0f, 1000.0f, 100.0f}, found);
+  CHECK(found.empty());
+  found.clear();
+  tree.QueryAABB(SDL_FRect{0.0f, 0.0f, 1000.0f, 1000.0f}, found, notFirst);
+  CHECK(found.size() == 3 && !contains(found, first));
+
+  // QueryPoint: inside, on an edge, and in empty space
+  found.clear();
+  tree.QueryPoint({210.0f, 10.0f}, found);
+  CHECK(found.size() == 1 && found[0] == second);
+  found.clear();
+  tree.QueryPoint({250.0f, 550.0f}, found);
+  CHECK(found.size() == 1 && found[0] == side);
+  found.clear();
+  tree.QueryPoint({150.0f, 10.0f}, found);
+  CHECK(found.empty());
+  found.clear();
+  tree.QueryPoint({210.0f, 10.0f}, found, notFirst);
+  CHECK(found.size() == 1);
+  tree.QueryPoint({110.0f, 10.0f}, found, notFirst);
+  CHECK(found.size() == 1);
+
+  // Moving within the margin is answered from current bounds before the
+  // next Update(): the box has left the old spot and is found at the new one
+  second->position.x += 5.0f;
+  found.clear();
+  tree.QueryPoint({202.0f, 10.0f}, found);
+  CHECK(found.empty());
+  tree.QueryPoint({223.0f, 10.0f}, found);
+  CHECK(found.size() == 1 && found[0] == second);
+  second->position.x -= 5.0f;
+
+  // Entities not owned by an EntityManager are paired but never returned
+  Entity unowned;
+  unowned.position = {105.0f, 5.0f};
+  unowned.dimensions = {10.0f, 10.0f};
+  entities.push_back(&unowned);
+  tree.Update(entities);
+  std::vector<CollisionPair> pairs;
+  tree.QueryPairs(pairs);
+  CHECK(pairs.size() == 1 && pairs[0].a == 0 && pairs[0].b == 4);
+  found.clear();
+  tree.QueryPoint({110.0f, 10.0f}, found);
+  CHECK(found.size() == 1 && found[0] == first);
+  CHECK(tree.Raycast({110.0f, 10.0f}, {110.0f, -100.0f}, hit));
+  CHECK(hit.entity == first);
+  entities.pop_back();
+
+  // Destroyed entities are skipped before the next Update()
+  manager.RemoveEntity(first);
+  delete first;
+  CHECK(tree.Raycast({0.0f, 10.0f}, {400.0f, 10.0f}, hit));
+  CHECK(hit.entity == second);
+  found.clear();
+  tree.QueryAABB(SDL_FRect{0.0f, 0.0f, 1000.0f, 1000.0f}, found);
+  CHECK(found.size() == 3 && !contains(found, first));
+
+  for (Entity *entity : std::vector<Entity *>(manager.getEntityVectorRef())) {
+    manager.RemoveEntity(entity);
+    delete entity;
+  }
+  return 0;
+}
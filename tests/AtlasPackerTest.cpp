@@ -0,0 +1,47 @@
+// Shelf packer: placements stay inside their page, padded and disjoint
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Check.h"
+#include "Core/AtlasPacker.h"
+
+int main() {
+  const int pageSize = 512;
+  const int padding = 2;
+
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> side(8, 200);
+  std::vector<std::pair<int, int>> sizes;
+  for (int i = 0; i < 120; ++i) sizes.push_back({side(rng), side(rng)});
+  sizes.push_back({pageSize + 1, 16});  // wider than a page
+  sizes.push_back({16, pageSize + 1});  // taller than a page
+
+  AtlasPacker packer(pageSize, padding);
+  std::vector<AtlasPacker::Placement> placements = packer.Pack(sizes);
+  CHECK(placements.size() == sizes.size());
+  CHECK(placements[sizes.size() - 2].page == -1);
+  CHECK(placements[sizes.size() - 1].page == -1);
+  CHECK(packer.GetPageCount() >= 2);
+  CHECK((int)packer.GetPageHeights().size() == packer.GetPageCount());
+
+  for (size_t i = 0; i + 2 < sizes.size(); ++i) {
+    const AtlasPacker::Placement &p = placements[i];
+    CHECK(p.page >= 0 && p.page < packer.GetPageCount());
+    CHECK(p.x >= 0 && p.y >= 0);
+    CHECK(p.x + sizes[i].first <= pageSize);
+    CHECK(p.y + sizes[i].second <= packer.GetPageHeights()[p.page]);
+
+    // Rects on the same page keep at least the padding between them
+    for (size_t j = i + 1; j + 2 < sizes.size(); ++j) {
+      const AtlasPacker::Placement &q = placements[j];
+      if (q.page != p.page) continue;
+      const bool apart = p.x + sizes[i].first + padding <= q.x ||
+                         q.x + sizes[j].first + padding <= p.x ||
+                         p.y + sizes[i].second + padding <= q.y ||
+                         q.y + sizes[j].second + padding <= p.y;
+      CHECK(apart);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,117 @@
+// Every broadphase must report each overlapping pair of a moving scene
+// exactly once, in sorted order, compared against a brute-force check
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Check.h"
+#include "Collision/AABBTree.h"
+#include "Collision/SpatialHash.h"
+#include "Collision/SweepAndPrune.h"
+
+namespace {
+
+bool overlaps(const SDL_FRect &a, const SDL_FRect &b) {
+  return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+template <typename Broadphase>
+void checkAgainstBruteForce(Broadphase &broadphase) {
+  EntityManager manager;
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> coord(-2000.0f, 2000.0f);
+  std::uniform_real_distribution<float> extent(1.0f, 200.0f);
+
+  std::vector<Entity *> entities;
+  for (int i = 0; i < 600; ++i) {
+    Entity *entity = new Entity();
+    entity->position = {coord(rng), coord(rng)};
+    entity->dimensions = {extent(rng), extent(rng)};
+    manager.AddEntity(entity);
+    entities.push_back(entity);
+  }
+  // Level-sized bodies exercise the oversized paths
+  entities[5]->dimensions = {5000.0f, 100.0f};
+  entities[7]->dimensions = {100.0f, 6000.0f};
+
+  std::vector<CollisionPair> pairs;
+  for (int frame = 0; frame < 20; ++frame) {
+    for (Entity *entity : entities) {
+      if (rng() % 3 == 0) entity->position.x += coord(rng) * 0.05f;
+    }
+    if (frame % 5 == 4) {
+      // Entities dropped from the list must disappear from the results
+      std::swap(entities[frame], entities.back());
+      entities.pop_back();
+    }
+
+    broadphase.Update(entities);
+    broadphase.QueryPairs(pairs);
+
+    std::set<std::pair<uint32_t, uint32_t>> reported;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      CHECK(pairs[i].a < pairs[i].b && pairs[i].b < entities.size());
+      if (i > 0) CHECK(pairs[i - 1] < pairs[i]);
+      reported.insert({pairs[i].a, pairs[i].b});
+    }
+    for (uint32_t i = 0; i < entities.size(); ++i) {
+      for (uint32_t j = i + 1; j < entities.size(); ++j) {
+        if (overlaps(entities[i]->GetBounds(), entities[j]->GetBounds())) {
+          CHECK(reported.count({i, j}) == 1);
+        }
+      }
+    }
+  }
+
+  for (Entity *entity : std::vector<Entity *>(manager.getEntityVectorRef())) {
+    manager.RemoveEntity(entity);
+    delete entity;
+  }
+}
+
+}  // namespace
+
+int main() {
+  SpatialHash grid(64.0f);
+  checkAgainstBruteForce(grid);
+
+  SweepAndPrune sweep;
+  checkAgainstBruteForce(sweep);
+
+  AABBTree tree;
+  checkAgainstBruteForce(tree);
+
+  // The tree's region query agrees with a linear scan
+  EntityManager manager;
+  std::vector<Entity *> entities;
+  for (int i = 0; i < 100; ++i) {
+    Entity *entity = new Entity();
+    entity->position = {(float)(i % 10) * 50.0f, (float)(i / 10) * 50.0f};
+    entity->dimensions = {40.0f, 40.0f};
+    manager.AddEntity(entity);
+    entities.push_back(entity);
+  }
+  tree.Update(entities);
+  const SDL_FRect region = {95.0f, 95.0f, 120.0f, 60.0f};
+  std::vector<Entity *> found;
+  tree.QueryAABB(region, found);
+  size_t expected = 0;
+  for (Entity *entity : entities) {
+    if (overlaps(entity->GetBounds(), region)) expected++;
+  }
+  CHECK(found.size() == expected && expected > 0);
+
+  // Removed entities are never returned, even before the next Update()
+  manager.RemoveEntity(found[0]);
+  delete found[0];
+  std::vector<Entity *> after;
+  tree.QueryAABB(region, after);
+  CHECK(after.size() == expected - 1);
+
+  for (Entity *entity : std::vector<Entity *>(manager.getEntityVectorRef())) {
+    manager.RemoveEntity(entity);
+    delete entity;
+  }
+  return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+
+// Assertion for the engine tests. Unlike assert() it stays on in release
+// builds, and it reports the failing expression and line before exiting
+// non-zero so ctest marks the test failed.
+#define CHECK(cond)                                                       \
+  do {                                                                    \
+    if (!(cond)) {                                                        \
+      std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, \
+                   #cond);                                                \
+      std::exit(1);                                                       \
+    }                                                                     \
+  } while (0)
@@ -0,0 +1,64 @@
+// Deferred spawns, despawns and component adds recorded from many threads
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Check.h"
+#include "Entities/Entity.h"
+#include "Entities/EntityCommandBuffer.h"
+
+int main() {
+  EntityManager manager;
+  EntityCommandBuffer &commands = manager.GetCommandBuffer();
+
+  std::atomic<int> spawned{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&commands, &spawned]() {
+      for (int i = 0; i < 100; ++i) {
+        commands.Spawn(new Entity(), [&spawned](Entity *, EntityHandle) { spawned++; });
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+
+  // Nothing is applied until the tick boundary
+  CHECK(manager.getEntityVectorRef().empty());
+  manager.FlushCommands();
+  CHECK(spawned == 400);
+  CHECK(manager.getEntityVectorRef().size() == 400);
+
+  std::vector<EntityHandle> handles;
+  for (Entity *entity : manager.getEntityVectorRef()) handles.push_back(entity->GetHandle());
+
+  const ComponentKey health("command_buffer_test_health");
+  for (size_t i = 0; i < handles.size(); i += 2) commands.Despawn(handles[i]);
+  // Adds to a handle despawned earlier in the same buffer are dropped
+  commands.AddComponent(handles[0], health, 5);
+  commands.AddComponent(handles[1], health, 7);
+  manager.FlushCommands();
+
+  CHECK(manager.getEntityVectorRef().size() == 200);
+  // Survivors keep the order they had before the flush
+  for (size_t i = 0; i < 200; ++i) {
+    CHECK(manager.getEntityVectorRef()[i]->GetHandle() == handles[2 * i + 1]);
+  }
+  CHECK(manager.Get(handles[0]) == nullptr);
+  CHECK(manager.Get(handles[1])->getComponent<int>(health) == 7);
+  for (size_t i = 1; i < handles.size(); i += 2) {
+    Entity *entity = manager.Get(handles[i]);
+    CHECK(entity && manager.FindById(entity->GetId()) == entity);
+  }
+
+  // Commands against handles that went stale are ignored
+  commands.Despawn(handles[0]);
+  commands.AddComponent(handles[2], health, 1);
+  manager.FlushCommands();
+  CHECK(manager.getEntityVectorRef().size() == 200);
+
+  for (Entity *entity : std::vector<Entity *>(manager.getEntityVectorRef())) {
+    manager.RemoveEntity(entity);
+    delete entity;
+  }
+  return 0;
+}
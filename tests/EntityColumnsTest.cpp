@@ -0,0 +1,120 @@
+// EntityColumns: entity fields alias stable rows, views carry matching row
+// lists, and the column physics pass matches the per-entity one
+#include <vector>
+
+#include "Check.h"
+#include "Core/JobSystem.h"
+#include "Entities/Entity.h"
+#include "Physics/Physics.h"
+
+namespace {
+
+void checkViewRows(const EntityManager &manager) {
+  for (EntityView view : {EntityView::Simulated, EntityView::Collidable, EntityView::Visible}) {
+    const std::vector<Entity *> &list = manager.GetView(view);
+    const std::vector<uint32_t> &rows = manager.GetViewRows(view);
+    CHECK(list.size() == rows.size());
+    for (size_t i = 0; i < list.size(); ++i) CHECK(list[i]->GetColumnRow() == rows[i]);
+  }
+}
+
+}  // namespace
+
+int main() {
+  const size_t liveBefore = EntityColumns::LiveRows();
+
+  // Fields are the row's columns
+  Entity *probe = new Entity(3.0f, 4.0f, 10.0f, 20.0f);
+  const uint32_t probeRow = probe->GetColumnRow();
+  CHECK(&probe->position == &EntityColumns::Position(probeRow));
+  CHECK(&probe->dimensions == &EntityColumns::Dimensions(probeRow));
+  CHECK(&probe->timeline == &EntityColumns::TimelineOf(probeRow));
+  CHECK(EntityColumns::Position(probeRow).x == 3.0f && EntityColumns::Dimensions(probeRow).y == 20.0f);
+  probe->EnablePhysics(false);
+  probe->SetVelocity(5.0f, -1.0f);
+  CHECK(EntityColumns::Velocity(probeRow).x == 5.0f && probe->GetVelocityY() == -1.0f);
+
+  // Growing past several chunks never moves an existing row
+  const vec2 *probeAddress = &probe->position;
+  std::vector<Entity *> bulk;
+  for (uint32_t i = 0; i < 3 * EntityColumns::kRowsPerChunk; ++i) {
+    bulk.push_back(new Entity((float)i, 0.0f));
+  }
+  CHECK(&probe->position == probeAddress && probe->position.x == 3.0f);
+  CHECK(EntityColumns::LiveRows() == liveBefore + 1 + bulk.size());
+  for (size_t i = 0; i < bulk.size(); ++i) CHECK(bulk[i]->position.x == (float)i);
+
+  // Freed rows are reused, and a reused row starts zeroed
+  const uint32_t freedRow = bulk.back()->GetColumnRow();
+  delete bulk.back();
+  bulk.pop_back();
+  Entity *reuse = new Entity();
+  CHECK(reuse->GetColumnRow() == freedRow);
+  CHECK(EntityColumns::Velocity(freedRow).x == 0.0f && reuse->timeline == nullptr);
+  bulk.push_back(reuse);
+  for (Entity *entity : bulk) delete entity;
+  delete probe;
+  CHECK(EntityColumns::LiveRows() == liveBefore);
+
+  // View row lists follow adds, flag changes and removals in both the
+  // swap-removed and the order-preserving views
+  EntityManager manager;
+  Timeline timeline;
+  timeline.Update(0.016f);
+  std::vector<Entity *> entities;
+  for (int i = 0; i < 200; ++i) {
+    Entity *entity = new Entity((float)i, (float)(i % 7), 8.0f, 8.0f, &timeline);
+    if (i % 2 == 0) entity->EnablePhysics(i % 4 == 0);
+    if (i % 3 == 0) entity->EnableCollision(false, i % 9 == 0);
+    manager.AddEntity(entity);
+    entities.push_back(entity);
+  }
+  checkViewRows(manager);
+  for (size_t i = 0; i < entities.size(); i += 5) entities[i]->SetVisible(false);
+  for (size_t i = 1; i < entities.size(); i += 6) entities[i]->EnablePhysics(true);
+  for (size_t i = 0; i < entities.size(); i += 11) {
+    manager.RemoveEntity(entities[i]);
+    delete entities[i];
+    entities[i] = nullptr;
+  }
+  checkViewRows(manager);
+
+  // One step over the Simulated rows gives exactly what the per-entity
+  // path computes from the same starting state
+  JobSystem jobs(3);
+  PhysicsSystem physics(jobs);
+  std::vector<vec2> expectedPosition, expectedVelocity;
+  for (Entity *entity : manager.GetView(EntityView::Simulated)) {
+    const uint32_t row = entity->GetColumnRow();
+    const vec2 velocity = add(EntityColumns::Velocity(row), mul(0.016f, EntityColumns::Force(row)));
+    expectedVelocity.push_back(velocity);
+    expectedPosition.push_back(add(entity->position, mul(0.016f, velocity)));
+  }
+  std::vector<vec2> untouched;
+  for (Entity *entity : manager.getEntityVectorRef()) untouched.push_back(entity->position);
+
+  physics.ApplyPhysicsMultithreaded(manager.GetViewRows(EntityView::Simulated));
+  const std::vector<Entity *> &simulated = manager.GetView(EntityView::Simulated);
+  CHECK(!simulated.empty());
+  for (size_t i = 0; i < simulated.size(); ++i) {
+    CHECK(simulated[i]->position.x == expectedPosition[i].x);
+    CHECK(simulated[i]->position.y == expectedPosition[i].y);
+    CHECK(simulated[i]->GetVelocityY() == expectedVelocity[i].y);
+  }
+  // Kinematic and physics-less entities stay put
+  const std::vector<Entity *> &all = manager.getEntityVectorRef();
+  for (size_t i = 0; i < all.size(); ++i) {
+    bool kinematic = all[i]->collisionEnabled &&
+                     all[i]->getComponent<CollisionComponent>(Components::Collision).isKinematic;
+    if (!all[i]->physicsEnabled || kinematic) {
+      CHECK(all[i]->position.x == untouched[i].x && all[i]->position.y == untouched[i].y);
+    }
+  }
+
+  for (Entity *entity : std::vector<Entity *>(manager.getEntityVectorRef())) {
+    manager.RemoveEntity(entity);
+    delete entity;
+  }
+  CHECK(EntityColumns::LiveRows() == liveBefore);
+  return 0;
+}
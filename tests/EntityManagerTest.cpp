@@ -0,0 +1,84 @@
+// Slot map behind EntityHandle: lookups, stale handles and slot reuse
+#include "Check.h"
+#include "Entities/Entity.h"
+
+int main() {
+  EntityManager manager;
+
+  Entity *a = new Entity();
+  Entity *b = new Entity();
+  EntityHandle ha = manager.AddEntity(a);
+  EntityHandle hb = manager.AddEntity(b);
+  CHECK(!ha.IsNull() && !hb.IsNull() && ha != hb);
+  CHECK(manager.Get(ha) == a && manager.Get(hb) == b);
+  CHECK(a->GetHandle() == ha && a->GetOwner() == &manager);
+  CHECK(manager.FindById(b->GetId()) == b);
+
+  // A removed entity's handle goes stale instead of dangling
+  const int idA = a->GetId();
+  manager.RemoveEntity(a);
+  delete a;
+  CHECK(manager.Get(ha) == nullptr);
+  CHECK(manager.FindById(idA) == nullptr);
+  CHECK(manager.Get(hb) == b);
+  CHECK(manager.getEntityVectorRef().size() == 1);
+
+  // The freed slot is reused with a new generation; the old handle stays dead
+  Entity *c = new Entity();
+  EntityHandle hc = manager.AddEntity(c);
+  CHECK(hc.index == ha.index && hc.generation != ha.generation);
+  CHECK(manager.Get(ha) == nullptr && manager.Get(hc) == c);
+
+  // Removal keeps the dense array consistent with the slots, and the
+  // survivors (in the array and in every view) keep their relative order
+  for (int i = 0; i < 64; ++i) {
+    Entity *entity = new Entity();
+    if (i % 2 == 0) entity->EnablePhysics(true);
+    if (i % 3 == 0) entity->EnableCollision(false, false);
+    manager.AddEntity(entity);
+  }
+  std::vector<Entity *> all = manager.getEntityVectorRef();
+  std::vector<Entity *> survivors;
+  std::vector<Entity *> collidable;
+  for (size_t i = 0; i < all.size(); ++i) {
+    if (i % 3 == 0) continue;
+    survivors.push_back(all[i]);
+    if (all[i]->collisionEnabled) collidable.push_back(all[i]);
+  }
+  for (size_t i = 0; i < all.size(); i += 3) {
+    manager.RemoveEntity(all[i]);
+    delete all[i];
+  }
+  CHECK(manager.getEntityVectorRef() == survivors);
+  CHECK(manager.GetView(EntityView::Visible) == survivors);
+  CHECK(manager.GetView(EntityView::Collidable) == collidable);
+  for (Entity *entity : manager.getEntityVectorRef()) {
+    CHECK(manager.Get(entity->GetHandle()) == entity);
+    CHECK(manager.FindById(entity->GetId()) == entity);
+  }
+
+  // Leaving and re-entering a view by flag change moves an entity to the
+  // end of that view without reordering the others
+  Entity *toggled = manager.GetView(EntityView::Simulated).front();
+  toggled->DisablePhysics();
+  const std::vector<Entity *> &simulatedView = manager.GetView(EntityView::Simulated);
+  std::vector<Entity *> simulatedNow(simulatedView.begin(), simulatedView.end());
+  std::vector<Entity *> expectedSimulated;
+  for (Entity *entity : survivors) {
+    if (entity->physicsEnabled) expectedSimulated.push_back(entity);
+  }
+  CHECK(simulatedNow == expectedSimulated);
+  toggled->EnablePhysics(true);
+  CHECK(manager.GetView(EntityView::Simulated).back() == toggled);
+
+  // Clearing detaches without deleting; the entities are still ours
+  std::vector<Entity *> remaining = manager.getEntityVectorRef();
+  manager.ClearAllEntities();
+  CHECK(manager.getEntityVectorRef().empty());
+  CHECK(manager.Get(hb) == nullptr && manager.Get(hc) == nullptr);
+  for (Entity *entity : remaining) {
+    CHECK(entity->GetOwner() == nullptr);
+    delete entity;
+  }
+  return 0;
+}
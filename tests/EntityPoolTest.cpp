@@ -0,0 +1,70 @@
+// Pooled Entity allocation and FlatMap component storage
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "Entities/Entity.h"
+#include "Entities/EntityPool.h"
+
+namespace {
+
+struct LargeEntity : Entity {
+  char payload[300] = {};
+};
+
+const EntityPoolStats *statsFor(const std::vector<EntityPoolStats> &stats, size_t size) {
+  const size_t blockSize =
+      (size + EntityPool::kClassGranularity - 1) / EntityPool::kClassGranularity *
+      EntityPool::kClassGranularity;
+  for (const EntityPoolStats &s : stats) {
+    if (s.blockSize == blockSize) return &s;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+int main() {
+  // Freed blocks are recycled: repeated spawn/despawn bursts of the same
+  // size do not grow the pool past the first burst
+  std::vector<Entity *> batch;
+  size_t capacityAfterFirst = 0;
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 200; ++i) {
+      batch.push_back(i % 2 ? new LargeEntity() : new Entity());
+    }
+    const EntityPoolStats *large = statsFor(EntityPool::GetStats(), sizeof(LargeEntity));
+    CHECK(large && large->live >= 100);
+    if (round == 0) capacityAfterFirst = large->capacity;
+    CHECK(large->capacity == capacityAfterFirst);
+    for (Entity *entity : batch) delete entity;
+    batch.clear();
+  }
+  const EntityPoolStats *large = statsFor(EntityPool::GetStats(), sizeof(LargeEntity));
+  CHECK(large && large->live == 0 && large->allocations == large->frees);
+
+  // Components stay reachable across the spill from inline to heap storage
+  Entity entity;
+  std::vector<ComponentKey> keys;
+  for (int i = 0; i < 12; ++i) {
+    keys.emplace_back("pool_test_" + std::to_string(i));
+    entity.setComponent(keys.back(), i);
+  }
+  for (int i = 0; i < 12; ++i) {
+    CHECK(entity.hasComponent(keys[i]));
+    CHECK(entity.getComponent<int>(keys[i]) == i);
+  }
+  entity.setComponent(keys[3], 33);
+  CHECK(entity.getComponent<int>(keys[3]) == 33);
+
+  const ComponentKey missing("pool_test_missing");
+  CHECK(!entity.hasComponent(missing));
+  bool threw = false;
+  try {
+    entity.getComponent<int>(missing);
+  } catch (const std::out_of_range &) {
+    threw = true;
+  }
+  CHECK(threw);
+  return 0;
+}
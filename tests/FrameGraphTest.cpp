@@ -0,0 +1,144 @@
+// FrameGraph: edges follow the declared resources, stages run after their
+// dependencies, independent stages overlap and main-thread stages stay on
+// the caller. Also checks that the engine's own frame lets rendering
+// overlap the simulation stages.
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Check.h"
+#include "Core/FrameGraph.h"
+#include "Core/GameEngine.h"
+
+namespace {
+
+using namespace FrameResource;
+
+int findStage(const FrameGraph &graph, const std::string &name) {
+  for (size_t i = 0; i < graph.GetStageCount(); ++i) {
+    if (graph.GetStageName((int)i) == name) return (int)i;
+  }
+  return -1;
+}
+
+bool reaches(const FrameGraph &graph, int from, int to) {
+  if (from == to) return true;
+  for (int next : graph.GetSuccessors(from)) {
+    if (reaches(graph, next, to)) return true;
+  }
+  return false;
+}
+
+// Exposes the engine's stage declarations without running a frame
+struct EngineProbe : GameEngine {
+  EngineProbe() : GameEngine(true) {}
+  using GameEngine::BuildFrameGraph;
+};
+
+}  // namespace
+
+int main() {
+  JobSystem jobs(3);
+
+  // Read-after-write, write-after-read and write-after-write each add an
+  // edge; stages sharing only reads do not
+  {
+    FrameGraph graph(jobs);
+    int write = graph.AddStage("write", None, Transforms, nullptr);
+    int readA = graph.AddStage("readA", Transforms, None, nullptr);
+    int readB = graph.AddStage("readB", Transforms, None, nullptr);
+    int rewrite = graph.AddStage("rewrite", None, Transforms, nullptr);
+    int other = graph.AddStage("other", None, Contacts, nullptr);
+    graph.Execute();
+    CHECK(reaches(graph, write, readA) && reaches(graph, write, readB));
+    CHECK(!reaches(graph, readA, readB) && !reaches(graph, readB, readA));
+    CHECK(reaches(graph, readA, rewrite) && reaches(graph, readB, rewrite));
+    CHECK(reaches(graph, write, rewrite));
+    for (int stage : {write, readA, readB, rewrite}) {
+      CHECK(!reaches(graph, stage, other) && !reaches(graph, other, stage));
+    }
+  }
+
+  // Dependencies finish before their successors start, every frame
+  for (int frame = 0; frame < 200; ++frame) {
+    FrameGraph graph(jobs);
+    std::atomic<int> step{0};
+    std::atomic<bool> ordered{true};
+    graph.AddStage("first", None, Time, [&]() { step = 1; });
+    graph.AddStage("second", Time, Entities, [&]() {
+      if (step.exchange(2) != 1) ordered = false;
+    });
+    graph.AddStage("third", Entities, Snapshot, [&]() {
+      if (step.exchange(3) != 2) ordered = false;
+    });
+    graph.Execute();
+    CHECK(ordered && step == 3);
+  }
+
+  // Two independent stages are in flight at the same time: each waits for
+  // the other to start
+  {
+    FrameGraph graph(jobs);
+    std::atomic<int> started{0};
+    std::atomic<bool> overlapped{true};
+    auto meet = [&]() {
+      started++;
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (started.load() < 2) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          overlapped = false;
+          return;
+        }
+        std::this_thread::yield();
+      }
+    };
+    graph.AddStage("left", None, Transforms, meet);
+    graph.AddStage("right", None, Snapshot, meet);
+    graph.Execute();
+    CHECK(overlapped);
+  }
+
+  // Main-thread stages run on the thread that called Execute
+  {
+    FrameGraph graph(jobs);
+    std::thread::id mainId;
+    std::atomic<int> ran{0};
+    graph.AddStage("worker", None, Entities, [&]() { ran++; });
+    graph.AddStage("main", Entities, Screen, [&]() {
+      mainId = std::this_thread::get_id();
+      ran++;
+    }, true);
+    graph.Execute();
+    CHECK(ran == 2 && mainId == std::this_thread::get_id());
+  }
+
+  // The engine frame: the simulation chain stays serial, render depends on
+  // none of it, and the capture it draws next frame waits for both
+  {
+    EngineProbe engine;
+    CHECK(engine.Initialize("FrameGraphTest", 64, 64, 1.0f));
+    std::vector<Entity *> entities;
+    FrameGraph graph(*engine.GetJobSystem());
+    engine.BuildFrameGraph(graph, 0.016f, entities, true);
+    graph.Execute();
+
+    const int input = findStage(graph, "input");
+    const int update = findStage(graph, "entities");
+    const int physics = findStage(graph, "physics");
+    const int collision = findStage(graph, "collision");
+    const int render = findStage(graph, "render");
+    const int capture = findStage(graph, "capture");
+    CHECK(input >= 0 && update >= 0 && physics >= 0 && collision >= 0);
+    CHECK(render >= 0 && capture >= 0);
+
+    CHECK(reaches(graph, update, physics) && reaches(graph, physics, collision));
+    CHECK(reaches(graph, input, render));
+    for (int stage : {update, physics, collision}) {
+      CHECK(!reaches(graph, stage, render) && !reaches(graph, render, stage));
+    }
+    CHECK(reaches(graph, collision, capture) && reaches(graph, render, capture));
+  }
+  return 0;
+}
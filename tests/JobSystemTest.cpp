@@ -0,0 +1,94 @@
+// JobSystem: the flat batch API reuses one pool across many frames, and
+// nested submissions with WaitForCounter neither lose jobs nor deadlock
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Check.h"
+#include "Core/JobSystem.h"
+
+int main() {
+  JobSystem jobs(4);
+  CHECK(jobs.GetNumThreads() == 4);
+
+  // Each batch runs all of its jobs exactly once before ExecuteJobs returns;
+  // ClearJobs starts the next batch
+  std::vector<std::atomic<int>> hits(64);
+  for (int frame = 0; frame < 500; ++frame) {
+    for (size_t i = 0; i < hits.size(); ++i) {
+      jobs.AddJob([&hits, i]() { hits[i].fetch_add(1, std::memory_order_relaxed); });
+    }
+    jobs.ExecuteJobs();
+    jobs.ClearJobs();
+    for (std::atomic<int> &hit : hits) CHECK(hit.load() == frame + 1);
+  }
+
+  // Cleared jobs never run, and an empty batch returns at once
+  std::atomic<int> cleared{0};
+  jobs.AddJob([&cleared]() { cleared++; });
+  jobs.ClearJobs();
+  jobs.ExecuteJobs();
+  CHECK(cleared == 0);
+
+  // Jobs that fan out and wait on their children from inside the pool. Each
+  // waiter keeps running queued work, so this finishes even with more
+  // blocked parents than workers
+  for (int round = 0; round < 50; ++round) {
+    std::atomic<int> leaves{0};
+    JobCounter roots;
+    for (int i = 0; i < 16; ++i) {
+      jobs.Submit([&jobs, &leaves]() {
+        JobCounter children;
+        for (int j = 0; j < 16; ++j) {
+          jobs.Submit([&jobs, &leaves]() {
+            JobCounter grandchildren;
+            for (int k = 0; k < 4; ++k) {
+              jobs.Submit([&leaves]() { leaves.fetch_add(1, std::memory_order_relaxed); },
+                          &grandchildren);
+            }
+            jobs.WaitForCounter(grandchildren);
+          }, &children);
+        }
+        jobs.WaitForCounter(children);
+      }, &roots);
+    }
+    jobs.WaitForCounter(roots);
+    CHECK(roots.IsDone());
+    CHECK(leaves == 16 * 16 * 4);
+  }
+
+  // Outside threads submitting at once land in the injection queue
+  std::atomic<int> injected{0};
+  JobCounter outside;
+  std::vector<std::thread> producers;
+  for (int t = 0; t < 4; ++t) {
+    producers.emplace_back([&jobs, &injected, &outside]() {
+      for (int i = 0; i < 2000; ++i) {
+        jobs.Submit([&injected]() { injected.fetch_add(1, std::memory_order_relaxed); },
+                    &outside);
+      }
+    });
+  }
+  for (std::thread &producer : producers) producer.join();
+  jobs.WaitForCounter(outside);
+  CHECK(injected == 8000);
+
+  // A waiter with nothing to run parks and is woken by the counter that
+  // finishes on a worker
+  for (int round = 0; round < 200; ++round) {
+    std::atomic<bool> release{false};
+    JobCounter slow;
+    jobs.Submit([&release]() {
+      while (!release.load()) std::this_thread::yield();
+    }, &slow);
+    std::thread releaser([&release]() {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+      release = true;
+    });
+    jobs.WaitForCounter(slow);
+    CHECK(slow.IsDone());
+    releaser.join();
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+// The parallel narrowphase must leave a fixed scene exactly as the serial
+// path does: same final positions and the same OnCollision calls in the
+// same order, for every broadphase
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "Collision/Collisions.h"
+
+namespace {
+
+struct CollisionEvent {
+  size_t self;
+  size_t other;
+  vec2 normal;
+  vec2 point;
+};
+
+struct Probe : Entity {
+  std::vector<CollisionEvent> *events;
+  size_t index;
+
+  Probe(std::vector<CollisionEvent> *events, size_t index) : events(events), index(index) {}
+
+  void OnCollision(Entity *other, CollisionData *data) override {
+    events->push_back({index, static_cast<Probe *>(other)->index, data->normal, data->point});
+  }
+};
+
+struct Outcome {
+  std::vector<vec2> positions;
+  std::vector<CollisionEvent> events;
+  size_t pairs = 0;
+};
+
+Outcome simulate(BroadphaseMode mode, bool parallel, JobSystem &jobs) {
+  Outcome outcome;
+  EntityManager manager;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> coord(0.0f, 3000.0f);
+  std::uniform_real_distribution<float> extent(10.0f, 80.0f);
+
+  // Dense enough that passes exceed kMinParallelPairs and that resolving
+  // one pair moves bodies shared with later pairs
+  std::vector<Entity *> entities;
+  for (size_t i = 0; i < 2000; ++i) {
+    Probe *probe = new Probe(&outcome.events, i);
+    probe->position = {coord(rng), coord(rng) * 0.3f};
+    probe->dimensions = {extent(rng), extent(rng)};
+    probe->EnableCollision(i % 17 == 0, i % 5 == 0);
+    manager.AddEntity(probe);
+    entities.push_back(probe);
+  }
+
+  CollisionSystem collision;
+  collision.SetJobSystem(&jobs);
+  collision.SetParallelNarrowphase(parallel);
+  collision.SetBroadphase(mode);
+  for (int frame = 0; frame < 10; ++frame) {
+    for (size_t i = 0; i < entities.size(); ++i) {
+      entities[i]->position.x += (float)(i % 3) - 1.0f;
+    }
+    collision.ProcessCollisions(entities);
+    outcome.pairs += collision.GetLastPairCount();
+  }
+
+  for (Entity *entity : entities) {
+    outcome.positions.push_back(entity->position);
+    manager.RemoveEntity(entity);
+    delete entity;
+  }
+  return outcome;
+}
+
+}  // namespace
+
+int main() {
+  JobSystem jobs(4);
+  for (BroadphaseMode mode : {BroadphaseMode::BruteForce, BroadphaseMode::SpatialHash,
+                              BroadphaseMode::SweepAndPrune, BroadphaseMode::AABBTree}) {
+    Outcome serial = simulate(mode, false, jobs);
+    Outcome parallel = simulate(mode, true, jobs);
+
+    CHECK(serial.pairs >= 10 * CollisionSystem::kMinParallelPairs);
+    CHECK(!serial.events.empty());
+
+    CHECK(serial.positions.size() == parallel.positions.size());
+    for (size_t i = 0; i < serial.positions.size(); ++i) {
+      CHECK(serial.positions[i].x == parallel.positions[i].x);
+      CHECK(serial.positions[i].y == parallel.positions[i].y);
+    }
+
+    CHECK(serial.events.size() == parallel.events.size());
+    for (size_t i = 0; i < serial.events.size(); ++i) {
+      const CollisionEvent &a = serial.events[i];
+      const CollisionEvent &b = parallel.events[i];
+      CHECK(a.self == b.self && a.other == b.other);
+      CHECK(a.normal.x == b.normal.x && a.normal.y == b.normal.y);
+      CHECK(a.point.x == b.point.x && a.point.y == b.point.y);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,56 @@
+// TransformRects (AVX, SSE or scalar, whichever this build compiled) must
+// match TransformRectsScalar bit for bit, for every count including the
+// tails left over after whole SIMD steps
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "Math/TransformBatch.h"
+
+int main() {
+  std::printf("TransformRects path: %s\n", TransformRectsPath());
+
+  // Empty input with null arrays, as from empty vectors, does nothing
+  TransformRects(nullptr, nullptr, 0, RectTransform{}, nullptr);
+
+  std::mt19937 rng(19);
+  std::uniform_real_distribution<float> value(-5000.0f, 5000.0f);
+  std::uniform_real_distribution<float> factor(-3.0f, 3.0f);
+
+  // Counts 1..33 cover every remainder after 2- and 4-wide steps; the
+  // offset start makes the arrays misaligned for the vector loads
+  for (size_t count = 1; count <= 33; ++count) {
+    for (size_t offset = 0; offset < 3; ++offset) {
+      std::vector<vec2> positions(count + offset), dimensions(count + offset);
+      for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = {value(rng), value(rng)};
+        dimensions[i] = {value(rng), value(rng)};
+      }
+      RectTransform transform;
+      transform.translate = {value(rng), value(rng)};
+      transform.scale = {factor(rng), factor(rng)};
+
+      // One extra rect past the end must stay untouched
+      const RectF sentinel = {1.0f, 2.0f, 3.0f, 4.0f};
+      std::vector<RectF> simd(count + 1, sentinel), scalar(count + 1, sentinel);
+      TransformRects(positions.data() + offset, dimensions.data() + offset, count,
+                     transform, simd.data());
+      TransformRectsScalar(positions.data() + offset, dimensions.data() + offset,
+                           count, transform, scalar.data());
+
+      for (size_t i = 0; i < count; ++i) {
+        CHECK(simd[i].x == scalar[i].x && simd[i].y == scalar[i].y);
+        CHECK(simd[i].w == scalar[i].w && simd[i].h == scalar[i].h);
+      }
+      CHECK(simd[count].x == sentinel.x && simd[count].h == sentinel.h);
+
+      // And the scalar path is the formula in the header
+      const vec2 &p = positions[offset];
+      const vec2 &d = dimensions[offset];
+      CHECK(scalar[0].x == (p.x + transform.translate.x) * transform.scale.x);
+      CHECK(scalar[0].h == d.y * transform.scale.y);
+    }
+  }
+  return 0;
+}